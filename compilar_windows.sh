@@ -26,20 +26,16 @@ rm -f examples/*.exe
 mkdir -p lib
 
 echo "[2/6] Compilando archivos fuente..."
-x86_64-w64-mingw32-gcc -Wall -Wextra -I./include -c src/lanzarProcesoPar.c -o lib/lanzarProcesoPar_win.o
-if [ $? -ne 0 ]; then echo "Error compilando lanzarProcesoPar.c"; exit 1; fi
-
-x86_64-w64-mingw32-gcc -Wall -Wextra -I./include -c src/destruirProcesoPar.c -o lib/destruirProcesoPar_win.o
-if [ $? -ne 0 ]; then echo "Error compilando destruirProcesoPar.c"; exit 1; fi
-
-x86_64-w64-mingw32-gcc -Wall -Wextra -I./include -c src/enviarMensajeProcesoPar.c -o lib/enviarMensajeProcesoPar_win.o
-if [ $? -ne 0 ]; then echo "Error compilando enviarMensajeProcesoPar.c"; exit 1; fi
-
-x86_64-w64-mingw32-gcc -Wall -Wextra -I./include -c src/establecerFuncionDeEscucha.c -o lib/establecerFuncionDeEscucha_win.o
-if [ $? -ne 0 ]; then echo "Error compilando establecerFuncionDeEscucha.c"; exit 1; fi
+OBJETOS=""
+for fuente in src/*.c; do
+    nombre=$(basename "$fuente" .c)
+    x86_64-w64-mingw32-gcc -Wall -Wextra -I./include -c "$fuente" -o "lib/${nombre}_win.o"
+    if [ $? -ne 0 ]; then echo "Error compilando ${nombre}.c"; exit 1; fi
+    OBJETOS="$OBJETOS lib/${nombre}_win.o"
+done
 
 echo "[3/6] Creando biblioteca estática..."
-x86_64-w64-mingw32-ar rcs lib/libprocesopar_win.a lib/lanzarProcesoPar_win.o lib/destruirProcesoPar_win.o lib/enviarMensajeProcesoPar_win.o lib/establecerFuncionDeEscucha_win.o
+x86_64-w64-mingw32-ar rcs lib/libprocesopar_win.a $OBJETOS
 if [ $? -ne 0 ]; then echo "Error creando biblioteca"; exit 1; fi
 
 echo "[4/6] Compilando proceso_hijo.exe..."
@@ -0,0 +1,122 @@
+/**
+ * @file bench_delimitadores.c
+ * @brief Compara buscarDelimitadores con el bucle escalar de memchr
+ *
+ * Este programa (solo Linux):
+ * - Llena un buffer con líneas de distintas longitudes terminadas en '\n'
+ * - Lo recorre con memchr repetido (una llamada por línea) y con
+ *   buscarDelimitadores (una pasada vectorizada por lote de posiciones)
+ * - Muestra GB/s y millones de líneas por segundo de cada variante
+ *
+ * Uso: ./bench_delimitadores [megabytes]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/ProcesoPar.h"
+
+#define MEGABYTES_DEFECTO 64
+#define VUELTAS 5
+
+/* Evita que el compilador descarte el resultado */
+static volatile unsigned long long sumidero;
+
+static unsigned long long ahoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * @brief Bucle de referencia: memchr desde el byte siguiente a cada línea
+ */
+static unsigned long long contarMemchr(const char *datos, size_t longitud) {
+    unsigned long long lineas = 0;
+    const char *p = datos;
+    const char *fin = datos + longitud;
+    while (p < fin) {
+        const char *nl = (const char*)memchr(p, '\n', (size_t)(fin - p));
+        if (nl == NULL) {
+            break;
+        }
+        lineas++;
+        p = nl + 1;
+    }
+    return lineas;
+}
+
+/**
+ * @brief Lotes de buscarDelimitadores, como hace el proceso par al separar mensajes
+ */
+static unsigned long long contarLotes(const char *datos, size_t longitud, int lote) {
+    static uint32_t posiciones[4096];
+    unsigned long long lineas = 0;
+    size_t desde = 0;
+    while (desde < longitud) {
+        int numero = 0;
+        size_t revisados = 0;
+        buscarDelimitadores(datos + desde, longitud - desde, '\n', posiciones, lote, &numero, &revisados);
+        lineas += (unsigned long long)numero;
+        if (numero > 0) {
+            sumidero += posiciones[numero - 1];
+        }
+        desde += revisados;
+    }
+    return lineas;
+}
+
+/**
+ * @brief Mide una variante: mejor de VUELTAS pasadas
+ */
+static void medir(const char *nombre, const char *datos, size_t longitud, int lote) {
+    unsigned long long mejor = ~0ULL, lineas = 0;
+    for (int v = 0; v < VUELTAS; v++) {
+        unsigned long long t0 = ahoraNs();
+        lineas = (lote == 0) ? contarMemchr(datos, longitud) : contarLotes(datos, longitud, lote);
+        unsigned long long ns = ahoraNs() - t0;
+        if (ns < mejor) {
+            mejor = ns;
+        }
+    }
+    sumidero += lineas;
+    printf("  %-26s %7.2f GB/s   %8.1f Mlíneas/s\n",
+           nombre, (double)longitud / (double)mejor, lineas * 1000.0 / (double)mejor);
+}
+
+int main(int argc, char *argv[]) {
+    int megabytes = (argc > 1) ? atoi(argv[1]) : MEGABYTES_DEFECTO;
+    if (megabytes <= 0) {
+        megabytes = MEGABYTES_DEFECTO;
+    }
+    size_t longitud = (size_t)megabytes * 1024 * 1024;
+
+    char *datos = (char*)malloc(longitud);
+    if (datos == NULL) {
+        printf("Sin memoria\n");
+        return 1;
+    }
+
+    printf("==============================================\n");
+    printf("  SEPARACIÓN DE LÍNEAS (%d MB)\n", megabytes);
+    printf("==============================================\n");
+
+    const int longitudesLinea[] = {8, 32, 128, 1024, 16384};
+    for (size_t k = 0; k < sizeof(longitudesLinea) / sizeof(longitudesLinea[0]); k++) {
+        int linea = longitudesLinea[k];
+
+        /* Líneas de longitud fija con contenido que no es '\n' */
+        for (size_t i = 0; i < longitud; i++) {
+            datos[i] = ((i + 1) % (size_t)linea == 0) ? '\n' : (char)('a' + i % 26);
+        }
+
+        printf("Líneas de %d bytes:\n", linea);
+        medir("memchr por línea", datos, longitud, 0);
+        medir("buscarDelimitadores x64", datos, longitud, PROCESOPAR_LIMITES_LOTE);
+        medir("buscarDelimitadores x4096", datos, longitud, 4096);
+    }
+
+    free(datos);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file bench_latencia.c
+ * @brief Mide la latencia de ida y vuelta PING/PONG con distintas ubicaciones
+ *
+ * Este programa (solo Linux):
+ * - Lanza proceso_hijo con cada configuración de ubicación
+ * - Envía PING y espera el PONG, muchas veces, con la función de escucha
+ *   o con recepción por sondeo (sin hilo, con y sin giro)
+ * - Muestra percentiles de latencia para comparar configuraciones
+ *
+ * Uso: ./bench_latencia [iteraciones]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include "../include/ProcesoPar.h"
+
+#define ITERACIONES_DEFECTO 2000
+
+/* Formas de esperar la respuesta */
+#define MODO_ESCUCHA 0      /* Hilo de escucha + semáforo */
+#define MODO_SONDEO  1      /* recibirMensajesProcesoPar tras bloquearse en poll */
+#define MODO_GIRO    2      /* Igual, pero girando antes de bloquearse */
+
+#define US_GIRO 200
+
+/* Semáforo que la función de escucha libera con cada respuesta */
+static sem_t respuesta;
+
+static Estado_t funcionEscucha(const char *mensaje, int longitud) {
+    (void)mensaje;
+    (void)longitud;
+    sem_post(&respuesta);
+    return E_OK;
+}
+
+static unsigned long long ahoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+static int compararNs(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a;
+    unsigned long long y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Espera el PONG según el modo de recepción
+ */
+static void esperarRespuesta(ProcesoPar_t *pp, int modo) {
+    if (modo == MODO_ESCUCHA) {
+        sem_wait(&respuesta);
+        return;
+    }
+
+    char buffer[64];
+    MensajeRecibido_t mensaje = { buffer, sizeof(buffer), 0 };
+    int recibidos = 0;
+    while (recibidos == 0) {
+        if (esperarMensajesProcesoPar(pp, modo == MODO_GIRO ? US_GIRO : 0, -1) != E_OK ||
+            recibirMensajesProcesoPar(pp, &mensaje, 1, &recibidos) != E_OK) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Lanza el hijo con las opciones dadas y mide N idas y vueltas
+ */
+static void medir(const char *nombre, const OpcionesProcesoPar_t *opciones, int iteraciones, int modo) {
+    const char *args[] = {"proceso_hijo", NULL};
+    ProcesoPar_t *pp = NULL;
+
+    /* El hijo de ejemplo escribe una traza por mensaje en stderr: silenciarla */
+    int stderrOriginal = dup(STDERR_FILENO);
+    int nulo = open("/dev/null", O_WRONLY);
+    dup2(nulo, STDERR_FILENO);
+    close(nulo);
+
+    Estado_t estado = lanzarProcesoParConOpciones("./proceso_hijo", args, opciones, &pp);
+
+    dup2(stderrOriginal, STDERR_FILENO);
+    close(stderrOriginal);
+
+    if (estado != E_OK) {
+        printf("%-28s no se pudo lanzar (código %u)\n", nombre, estado);
+        return;
+    }
+
+    if (modo == MODO_ESCUCHA && establecerFuncionDeEscucha(pp, funcionEscucha) != E_OK) {
+        printf("%-28s no se pudo crear el hilo de escucha\n", nombre);
+        destruirProcesoPar(pp);
+        return;
+    }
+
+    unsigned long long *muestras = (unsigned long long*)malloc((size_t)iteraciones * sizeof(*muestras));
+    if (muestras == NULL) {
+        destruirProcesoPar(pp);
+        return;
+    }
+
+    /* Calentamiento y medición */
+    for (int i = -100; i < iteraciones; i++) {
+        unsigned long long t0 = ahoraNs();
+        enviarMensajeProcesoPar(pp, "PING\n", 5);
+        esperarRespuesta(pp, modo);
+        if (i >= 0) {
+            muestras[i] = ahoraNs() - t0;
+        }
+    }
+
+    qsort(muestras, (size_t)iteraciones, sizeof(*muestras), compararNs);
+    printf("%-28s p50 %7.1f us   p90 %7.1f us   p99 %7.1f us   max %8.1f us\n",
+           nombre,
+           muestras[iteraciones / 2] / 1000.0,
+           muestras[iteraciones * 9 / 10] / 1000.0,
+           muestras[iteraciones * 99 / 100] / 1000.0,
+           muestras[iteraciones - 1] / 1000.0);
+
+    free(muestras);
+    destruirProcesoPar(pp);
+}
+
+int main(int argc, char *argv[]) {
+    int iteraciones = (argc > 1) ? atoi(argv[1]) : ITERACIONES_DEFECTO;
+    if (iteraciones <= 0) {
+        iteraciones = ITERACIONES_DEFECTO;
+    }
+
+    sem_init(&respuesta, 0, 0);
+
+    printf("==============================================\n");
+    printf("  LATENCIA PING/PONG (%d iteraciones)\n", iteraciones);
+    printf("==============================================\n");
+
+    /* 1. Sin ubicación: el planificador decide */
+    OpcionesProcesoPar_t libre;
+    inicializarOpcionesProcesoPar(&libre);
+    medir("sin ubicacion", &libre, iteraciones, MODO_ESCUCHA);
+
+    /* 2. Compacta: hijo y escucha en CPUs vecinas del mismo nodo */
+    int cpuHijo, cpuEscucha, nodoHijo, nodoEscucha;
+    OpcionesProcesoPar_t compacta;
+    inicializarOpcionesProcesoPar(&compacta);
+    Estado_t estadoCompacta =
+        calcularUbicacionProcesoPar(0, PROCESOPAR_UBICACION_COMPACTA, &cpuHijo, &nodoHijo);
+    if (estadoCompacta == E_OK) {
+        estadoCompacta =
+            calcularUbicacionProcesoPar(1, PROCESOPAR_UBICACION_COMPACTA, &cpuEscucha, &nodoEscucha);
+    }
+    if (estadoCompacta == E_OK) {
+        compacta.cpusHijo = &cpuHijo;
+        compacta.numCpusHijo = 1;
+        compacta.cpusEscucha = &cpuEscucha;
+        compacta.numCpusEscucha = 1;
+        printf("(compacta: hijo CPU %d nodo %d, escucha CPU %d nodo %d)\n",
+               cpuHijo, nodoHijo, cpuEscucha, nodoEscucha);
+        medir("compacta", &compacta, iteraciones, MODO_ESCUCHA);
+    } else {
+        printf("(compacta: sin topología, código %u; se omite)\n", estadoCompacta);
+    }
+
+    /* 3. Dispersa: con dos o más nodos, hijo y escucha en nodos distintos */
+    int cpuHijoD, cpuEscuchaD, nodoHijoD, nodoEscuchaD;
+    OpcionesProcesoPar_t dispersa;
+    inicializarOpcionesProcesoPar(&dispersa);
+    Estado_t estadoDispersa =
+        calcularUbicacionProcesoPar(0, PROCESOPAR_UBICACION_DISPERSA, &cpuHijoD, &nodoHijoD);
+    if (estadoDispersa == E_OK) {
+        estadoDispersa =
+            calcularUbicacionProcesoPar(1, PROCESOPAR_UBICACION_DISPERSA, &cpuEscuchaD, &nodoEscuchaD);
+    }
+    if (estadoDispersa == E_OK) {
+        dispersa.cpusHijo = &cpuHijoD;
+        dispersa.numCpusHijo = 1;
+        dispersa.cpusEscucha = &cpuEscuchaD;
+        dispersa.numCpusEscucha = 1;
+        printf("(dispersa: hijo CPU %d nodo %d, escucha CPU %d nodo %d)\n",
+               cpuHijoD, nodoHijoD, cpuEscuchaD, nodoEscuchaD);
+        medir("dispersa", &dispersa, iteraciones, MODO_ESCUCHA);
+    } else {
+        printf("(dispersa: sin topología, código %u; se omite)\n", estadoDispersa);
+    }
+
+    /* 4. Misma CPU para todo: sin migraciones pero con cambios de contexto */
+    if (estadoCompacta == E_OK) {
+        OpcionesProcesoPar_t mismaCpu = compacta;
+        mismaCpu.cpusEscucha = &cpuHijo;
+        medir("hijo y escucha misma CPU", &mismaCpu, iteraciones, MODO_ESCUCHA);
+    }
+
+    /* 5. Sin hilo de escucha: el hilo que envía recibe directamente */
+    medir("sondeo sin hilo", &libre, iteraciones, MODO_SONDEO);
+    medir("sondeo con giro", &libre, iteraciones, MODO_GIRO);
+
+    sem_destroy(&respuesta);
+    return 0;
+}
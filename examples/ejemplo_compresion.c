@@ -0,0 +1,151 @@
+/**
+ * @file ejemplo_compresion.c
+ * @brief Ejemplo de negociación de la compresión PPLZ con hijo_pplz
+ *
+ * Este programa (solo Linux):
+ * - Lanza hijo_pplz ofreciendo la compresión y envía mensajes grandes y
+ *   pequeños, esperando cada eco; muestra las estadísticas de compresión
+ * - Lanza hijo_pplz con un saludo más lento que msNegociacion: ambos lados
+ *   siguen sin tramas y el saludo tardío no llega como mensaje
+ * - Termina con código 1 si alguna respuesta no es la esperada
+ *
+ * Uso: ./ejemplo_compresion [envíos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/ProcesoPar.h"
+
+static int errores;
+
+/* Respuesta que acumula la función de escucha */
+static pthread_mutex_t mutexRespuesta = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t condRespuesta = PTHREAD_COND_INITIALIZER;
+static char *respuesta;
+static int capacidadRespuesta;
+static int longitudRespuesta;
+
+/**
+ * @brief Función de escucha: sin tramas una respuesta puede llegar en trozos
+ */
+static Estado_t escuchar(const char *mensaje, int longitud) {
+    pthread_mutex_lock(&mutexRespuesta);
+    if (longitudRespuesta + longitud <= capacidadRespuesta) {
+        memcpy(respuesta + longitudRespuesta, mensaje, (size_t)longitud);
+    }
+    longitudRespuesta += longitud;
+    pthread_cond_signal(&condRespuesta);
+    pthread_mutex_unlock(&mutexRespuesta);
+    return E_OK;
+}
+
+/**
+ * @brief Envía al hijo y comprueba que responde "ECO: " + mensaje
+ */
+static void comprobarEco(ProcesoPar_t *pp, const char *mensaje, int longitud) {
+    int esperada = longitud + 5;
+
+    pthread_mutex_lock(&mutexRespuesta);
+    longitudRespuesta = 0;
+    pthread_mutex_unlock(&mutexRespuesta);
+
+    Estado_t estado = enviarMensajeProcesoPar(pp, mensaje, longitud);
+
+    struct timespec limite;
+    clock_gettime(CLOCK_REALTIME, &limite);
+    limite.tv_sec += 2;
+
+    pthread_mutex_lock(&mutexRespuesta);
+    while (estado == E_OK && longitudRespuesta < esperada &&
+           pthread_cond_timedwait(&condRespuesta, &mutexRespuesta, &limite) == 0) {
+    }
+    int recibida = longitudRespuesta;
+    pthread_mutex_unlock(&mutexRespuesta);
+
+    if (estado != E_OK || recibida != esperada ||
+        memcmp(respuesta, "ECO: ", 5) != 0 || memcmp(respuesta + 5, mensaje, (size_t)longitud) != 0) {
+        printf("  respuesta inesperada (código %u, %d bytes)\n", estado, recibida);
+        errores++;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int envios = (argc > 1) ? atoi(argv[1]) : 200;
+    if (envios <= 0) {
+        printf("Uso: %s [envíos]\n", argv[0]);
+        return 1;
+    }
+
+    /* Un mensaje grande y repetitivo, que se comprime bien */
+    int longitudGrande = 16 * 1024;
+    char *grande = (char*)malloc((size_t)longitudGrande + 1);
+    capacidadRespuesta = longitudGrande + 64;
+    respuesta = (char*)malloc((size_t)capacidadRespuesta);
+    if (grande == NULL || respuesta == NULL) {
+        return 1;
+    }
+    for (int i = 0; i < longitudGrande; i++) {
+        grande[i] = "registro de ejemplo;"[i % 20];
+    }
+    grande[longitudGrande - 1] = '\n';
+
+    OpcionesProcesoPar_t opciones;
+    inicializarOpcionesProcesoPar(&opciones);
+    opciones.compresion = 1;
+
+    /* 1. El hijo saluda a tiempo: tramas comprimidas en ambos sentidos */
+    const char *args[] = {"hijo_pplz", NULL};
+    ProcesoPar_t *pp = NULL;
+    if (lanzarProcesoParConOpciones("./hijo_pplz", args, &opciones, &pp) != E_OK) {
+        printf("No se pudo lanzar hijo_pplz\n");
+        return 1;
+    }
+    establecerFuncionDeEscucha(pp, escuchar);
+    printf("Compresión negociada: %s\n", pp->compresion ? "sí" : "no");
+    if (!pp->compresion) {
+        errores++;
+    }
+
+    for (int i = 0; i < envios; i++) {
+        char pequeno[32];
+        int longitud = snprintf(pequeno, sizeof(pequeno), "pequeño %d\n", i);
+        comprobarEco(pp, pequeno, longitud);
+        comprobarEco(pp, grande, longitudGrande);
+    }
+
+    EstadisticasCompresion_t e;
+    obtenerEstadisticasCompresion(pp, &e);
+    printf("  enviados: %llu comprimidos (%llu -> %llu bytes), %llu sin comprimir\n",
+           e.mensajesComprimidos, e.bytesOriginalesEnviados, e.bytesComprimidosEnviados,
+           e.mensajesSinComprimir);
+    printf("  recibidos: %llu comprimidos (%llu -> %llu bytes)\n",
+           e.mensajesDescomprimidos, e.bytesComprimidosRecibidos, e.bytesOriginalesRecibidos);
+    destruirProcesoPar(pp);
+
+    /* 2. El saludo llega tarde: sin tramas, y el saludo no es un mensaje */
+    const char *argsLento[] = {"hijo_pplz", "300", NULL};
+    opciones.msNegociacion = 50;
+    if (lanzarProcesoParConOpciones("./hijo_pplz", argsLento, &opciones, &pp) != E_OK) {
+        printf("No se pudo lanzar hijo_pplz\n");
+        return 1;
+    }
+    establecerFuncionDeEscucha(pp, escuchar);
+    printf("Saludo tardío, compresión negociada: %s\n", pp->compresion ? "sí" : "no");
+    if (pp->compresion) {
+        errores++;
+    }
+    for (int i = 0; i < 10; i++) {
+        char linea[32];
+        int longitud = snprintf(linea, sizeof(linea), "linea %d\n", i);
+        comprobarEco(pp, linea, longitud);
+    }
+    destruirProcesoPar(pp);
+
+    free(grande);
+    free(respuesta);
+    printf("Errores: %d\n", errores);
+    return errores == 0 ? 0 : 1;
+}
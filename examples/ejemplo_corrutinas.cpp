@@ -0,0 +1,116 @@
+/**
+ * @file ejemplo_corrutinas.cpp
+ * @brief Ejemplo de conversaciones con corrutinas C++20 (ProcesoParCorrutinas.hpp)
+ *
+ * Este programa (solo Linux):
+ * - Lanza varios proceso_hijo con delimitador '\n'
+ * - Atiende miles de conversaciones concurrentes desde un solo hilo: cada
+ *   una es una corrutina que llama al hijo con co_await y comprueba el eco
+ * - Muestra el rendimiento y cuántos marcos salieron del pool de cada par
+ *
+ * Uso: ./ejemplo_corrutinas [conversaciones] [llamadas por conversación] [hijos]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/ProcesoParCorrutinas.hpp"
+
+using namespace procesopar;
+
+static int errores;
+
+/* El primer parámetro Par & hace que el marco salga del pool del par */
+static Tarea<> conversacion(Par &par, int id, int llamadas) {
+    char peticion[32];
+    char esperada[40];
+    char respuesta[64];
+
+    for (int i = 0; i < llamadas; i++) {
+        int longitud = std::snprintf(peticion, sizeof(peticion), "c%d-%d\n", id, i);
+        std::snprintf(esperada, sizeof(esperada), "ECO: %s", peticion);
+
+        Recepcion r = co_await par.llamar(peticion, longitud, respuesta, sizeof(respuesta));
+        if (r.estado != E_OK || std::strcmp(respuesta, esperada) != 0) {
+            errores++;
+            co_return;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int conversaciones = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    int llamadas = (argc > 2) ? std::atoi(argv[2]) : 20;
+    int hijos = (argc > 3) ? std::atoi(argv[3]) : 4;
+    if (conversaciones <= 0 || llamadas <= 0 || hijos <= 0) {
+        std::printf("Uso: %s [conversaciones] [llamadas] [hijos]\n", argv[0]);
+        return 1;
+    }
+
+    OpcionesProcesoPar_t opciones;
+    inicializarOpcionesProcesoPar(&opciones);
+    opciones.delimitador = '\n';
+
+    /* El hijo de ejemplo escribe una traza por mensaje en stderr: silenciarla */
+    int stderrOriginal = dup(STDERR_FILENO);
+    int nulo = open("/dev/null", O_WRONLY);
+    dup2(nulo, STDERR_FILENO);
+    close(nulo);
+
+    const char *args[] = {"proceso_hijo", nullptr};
+    std::vector<ProcesoPar_t*> procesos(static_cast<size_t>(hijos), nullptr);
+    for (ProcesoPar_t *&pp : procesos) {
+        if (lanzarProcesoParConOpciones("./proceso_hijo", args, &opciones, &pp) != E_OK) {
+            dup2(stderrOriginal, STDERR_FILENO);
+            std::printf("No se pudo lanzar proceso_hijo\n");
+            return 1;
+        }
+    }
+
+    {
+        Bucle bucle;
+        std::vector<std::unique_ptr<Par>> pares;
+        for (ProcesoPar_t *pp : procesos) {
+            pares.push_back(std::make_unique<Par>(bucle, pp));
+            if (pares.back()->estado() != E_OK) {
+                std::printf("No se pudo vigilar el par (código %u)\n", pares.back()->estado());
+                return 1;
+            }
+        }
+
+        /* Las conversaciones se reparten entre los hijos. La segunda ronda
+         * reutiliza los marcos que liberó la primera */
+        auto inicio = std::chrono::steady_clock::now();
+        for (int ronda = 0; ronda < 2; ronda++) {
+            for (int c = 0; c < conversaciones; c++) {
+                bucle.lanzar(conversacion(*pares[static_cast<size_t>(c % hijos)], c, llamadas));
+            }
+            bucle.ejecutar();
+        }
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        dup2(stderrOriginal, STDERR_FILENO);
+        close(stderrOriginal);
+
+        long total = 2L * conversaciones * llamadas;
+        std::printf("2 rondas de %d conversaciones x %d llamadas con %d hijos en un hilo\n",
+                    conversaciones, llamadas, hijos);
+        std::printf("  %ld llamadas en %.3f s: %.0f llamadas/s\n", total, segundos, total / segundos);
+        for (size_t i = 0; i < pares.size(); i++) {
+            std::printf("  par %zu: %llu marcos creados, %llu reutilizados\n", i,
+                        static_cast<unsigned long long>(pares[i]->marcos().creados()),
+                        static_cast<unsigned long long>(pares[i]->marcos().reutilizados()));
+        }
+        std::printf("  errores: %d\n", errores);
+    }
+
+    for (ProcesoPar_t *pp : procesos) {
+        destruirProcesoPar(pp);
+    }
+    return errores == 0 ? 0 : 1;
+}
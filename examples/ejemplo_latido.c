@@ -0,0 +1,101 @@
+/**
+ * @file ejemplo_latido.c
+ * @brief Ejemplo del latido que relanza a un hijo atascado mientras se le envía
+ *
+ * Este programa (solo Linux):
+ * - Lanza como hijo `sleep`, que nunca lee ni responde
+ * - Activa el latido con relanzar = 1: el hijo se declara atascado y se
+ *   mata y relanza una y otra vez
+ * - Un hilo envía sin parar; al llenarse la tubería queda bloqueado hasta
+ *   que el relanzamiento mata al hijo, y ese envío debe fallar con
+ *   E_ENVIO_FALLO o E_PROCESO_INACT en vez de terminar el proceso con SIGPIPE
+ * - Termina con código 1 si no hubo relanzamientos o envíos fallidos
+ *
+ * Uso: ./ejemplo_latido [ms de prueba]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../include/ProcesoPar.h"
+
+static ProcesoPar_t *pp;
+static int detener;
+static unsigned long long enviados;
+static unsigned long long fallidos;
+static unsigned long long inesperados;
+
+/**
+ * @brief Envía mensajes de 1 KB hasta que se pida parar
+ */
+static void *hiloEmisor(void *param) {
+    char mensaje[1024];
+    memset(mensaje, 'x', sizeof(mensaje));
+    mensaje[sizeof(mensaje) - 1] = '\n';
+
+    while (!__atomic_load_n(&detener, __ATOMIC_ACQUIRE)) {
+        Estado_t estado = enviarMensajeProcesoPar(pp, mensaje, (int)sizeof(mensaje));
+        if (estado == E_OK) {
+            enviados++;
+        } else if (estado == E_ENVIO_FALLO || estado == E_PROCESO_INACT) {
+            /* Hijo muerto o en pleno relanzamiento */
+            fallidos++;
+            usleep(1000);
+        } else {
+            printf("  envío con código inesperado %u\n", estado);
+            inesperados++;
+        }
+    }
+    return param;
+}
+
+int main(int argc, char *argv[]) {
+    int msPrueba = (argc > 1) ? atoi(argv[1]) : 1000;
+    if (msPrueba <= 0) {
+        printf("Uso: %s [ms de prueba]\n", argv[0]);
+        return 1;
+    }
+
+    const char *args[] = {"sleep", "1000", NULL};
+    if (lanzarProcesoPar("sleep", args, &pp) != E_OK) {
+        printf("No se pudo lanzar sleep\n");
+        return 1;
+    }
+
+    OpcionesLatido_t opciones;
+    memset(&opciones, 0, sizeof(opciones));
+    opciones.msIntervalo = 50;
+    opciones.fallosMaximos = 2;
+    opciones.relanzar = 1;
+    if (activarLatidoProcesoPar(pp, &opciones) != E_OK) {
+        printf("No se pudo activar el latido\n");
+        destruirProcesoPar(pp);
+        return 1;
+    }
+
+    pthread_t emisor;
+    if (pthread_create(&emisor, NULL, hiloEmisor, NULL) != 0) {
+        destruirProcesoPar(pp);
+        return 1;
+    }
+
+    usleep((useconds_t)msPrueba * 1000);
+
+    /* Un emisor bloqueado en la tubería llena se libera con el siguiente relanzamiento */
+    __atomic_store_n(&detener, 1, __ATOMIC_RELEASE);
+    pthread_join(emisor, NULL);
+
+    EstadoLatido_t latido;
+    obtenerEstadoLatido(pp, &latido);
+    destruirProcesoPar(pp);
+
+    printf("Relanzamientos: %llu\n", latido.relanzamientos);
+    printf("Envíos: %llu correctos, %llu fallidos, %llu inesperados\n",
+           enviados, fallidos, inesperados);
+
+    int correcto = latido.relanzamientos > 0 && fallidos > 0 && inesperados == 0;
+    printf("%s\n", correcto ? "El proceso sobrevivió a los relanzamientos" : "Resultado inesperado");
+    return correcto ? 0 : 1;
+}
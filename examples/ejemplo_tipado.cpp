@@ -0,0 +1,169 @@
+/**
+ * @file ejemplo_tipado.cpp
+ * @brief Ejemplo de mensajes tipados con ProcesoParTipado.hpp
+ *
+ * Este programa (solo Linux) hace de padre y de hijo:
+ * - Como padre, se lanza a sí mismo con el argumento "hijo" y le envía
+ *   mensajes Consulta codificados en binario
+ * - Como hijo, lee registros de stdin con un Acumulador y responde a cada
+ *   Consulta con un Resultado
+ * - El padre despacha las respuestas por tipo, sin snprintf ni strcmp
+ *
+ * Uso: ./ejemplo_tipado [mensajes]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <unistd.h>
+#include <semaphore.h>
+#include "../include/ProcesoParTipado.hpp"
+
+using namespace procesopar;
+
+/* Tipos de mensaje: se declaran una sola vez */
+enum class Operacion : uint8_t { Suma = 1, Producto = 2 };
+
+struct Consulta {
+    static constexpr uint16_t tipo = 1;
+    uint32_t secuencia;
+    Operacion operacion;
+    std::array<int32_t, 4> operandos;
+    static constexpr auto campos() {
+        return std::make_tuple(&Consulta::secuencia, &Consulta::operacion, &Consulta::operandos);
+    }
+};
+
+struct Resultado {
+    static constexpr uint16_t tipo = 2;
+    uint32_t secuencia;
+    int64_t valor;
+    double media;
+    static constexpr auto campos() {
+        return std::make_tuple(&Resultado::secuencia, &Resultado::valor, &Resultado::media);
+    }
+};
+
+struct Error {
+    static constexpr uint16_t tipo = 3;
+    uint32_t secuencia;
+    char descripcion[32];
+    static constexpr auto campos() {
+        return std::make_tuple(&Error::secuencia, &Error::descripcion);
+    }
+};
+
+using DespachadorPadre = Despachador<Resultado, Error>;
+using DespachadorHijo = Despachador<Consulta>;
+
+/* ============================================================================
+ * HIJO
+ * ============================================================================ */
+
+static void escribirRegistro(const uint8_t *datos, size_t longitud) {
+    while (longitud > 0) {
+        ssize_t escritos = write(STDOUT_FILENO, datos, longitud);
+        if (escritos <= 0) {
+            std::exit(1);
+        }
+        datos += escritos;
+        longitud -= static_cast<size_t>(escritos);
+    }
+}
+
+static int hijo() {
+    static Acumulador<DespachadorHijo::registroMaximo()> acumulador;
+    char buffer[4096];
+
+    auto responder = [](const Consulta &c) {
+        Resultado r{};
+        r.secuencia = c.secuencia;
+        r.valor = (c.operacion == Operacion::Suma) ? 0 : 1;
+        for (int32_t x : c.operandos) {
+            r.valor = (c.operacion == Operacion::Suma) ? r.valor + x : r.valor * x;
+        }
+        r.media = static_cast<double>(r.valor) / c.operandos.size();
+
+        std::array<uint8_t, tamanoRegistro<Resultado>()> registro;
+        codificar(r, registro.data());
+        escribirRegistro(registro.data(), registro.size());
+    };
+
+    ssize_t leidos;
+    while ((leidos = read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+        if (acumulador.agregar<DespachadorHijo>(buffer, static_cast<size_t>(leidos), responder) < 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ============================================================================
+ * PADRE
+ * ============================================================================ */
+
+static sem_t respuestas;
+static int errores;
+
+/* La función de escucha no recibe contexto: el acumulador es global */
+static Acumulador<DespachadorPadre::registroMaximo()> acumuladorPadre;
+
+static Estado_t funcionEscucha(const char *mensaje, int longitud) {
+    acumuladorPadre.agregar<DespachadorPadre>(mensaje, static_cast<size_t>(longitud), Sobrecarga{
+        [](const Resultado &r) {
+            /* operandos = {s, s+1, s+2, s+3} */
+            int64_t esperado = 4 * static_cast<int64_t>(r.secuencia) + 6;
+            if (r.valor != esperado) {
+                errores++;
+            }
+            sem_post(&respuestas);
+        },
+        [](const Error &e) {
+            std::printf("Error del hijo en %u: %s\n", e.secuencia, e.descripcion);
+            errores++;
+            sem_post(&respuestas);
+        },
+    });
+    return E_OK;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && std::string_view(argv[1]) == "hijo") {
+        return hijo();
+    }
+
+    int mensajes = (argc > 1) ? std::atoi(argv[1]) : 10000;
+    if (mensajes <= 0) {
+        mensajes = 10000;
+    }
+
+    std::printf("Consulta: %zu bytes por registro, Resultado: %zu bytes\n",
+                tamanoRegistro<Consulta>(), tamanoRegistro<Resultado>());
+
+    sem_init(&respuestas, 0, 0);
+
+    const char *args[] = {"ejemplo_tipado", "hijo", nullptr};
+    ProcesoPar_t *pp = nullptr;
+    if (lanzarProcesoPar("/proc/self/exe", args, &pp) != E_OK ||
+        establecerFuncionDeEscucha(pp, funcionEscucha) != E_OK) {
+        std::printf("No se pudo lanzar el hijo\n");
+        return 1;
+    }
+
+    for (int i = 0; i < mensajes; i++) {
+        uint32_t s = static_cast<uint32_t>(i);
+        Consulta c{s, Operacion::Suma, {static_cast<int32_t>(s), static_cast<int32_t>(s + 1),
+                                        static_cast<int32_t>(s + 2), static_cast<int32_t>(s + 3)}};
+        if (enviar(pp, c) != E_OK) {
+            std::printf("Fallo al enviar\n");
+            break;
+        }
+        sem_wait(&respuestas);
+    }
+
+    std::printf("Mensajes: %d   Errores: %d\n", mensajes, errores);
+
+    destruirProcesoPar(pp);
+    sem_destroy(&respuestas);
+    return errores == 0 ? 0 : 1;
+}
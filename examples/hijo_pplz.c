@@ -0,0 +1,150 @@
+/**
+ * @file hijo_pplz.c
+ * @brief Proceso hijo de referencia que negocia la compresión PPLZ
+ *
+ * Este programa (solo Linux):
+ * - Si el padre ofrece PROCESOPAR_COMPRESION=PPLZ1, envía el saludo y
+ *   espera la primera línea de stdin
+ * - Si es la aceptación, lee y responde tramas, comprimiendo las respuestas
+ *   que superan PROCESOPAR_UMBRAL_COMPRESION; si no, esa línea es el primer
+ *   mensaje y sigue sin tramas
+ * - Responde a cada mensaje con "ECO: " seguido del mensaje
+ *
+ * Uso: ./hijo_pplz [ms de retraso antes del saludo]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/ProcesoPar.h"
+
+#define PREFIJO "ECO: "
+
+/**
+ * @brief Escribe una trama, comprimida si así ocupa menos
+ *
+ * `comprimido` debe tener al menos `longitud` bytes.
+ *
+ * @return 1 si se escribió, 0 si no
+ */
+static int escribirTrama(const char *mensaje, int longitud, char *comprimido) {
+    CabeceraTrama_t cabecera;
+    const char *carga = mensaje;
+
+    cabecera.longitud = (uint32_t)longitud;
+    cabecera.longitudOriginal = (uint32_t)longitud;
+
+    int longitudComprimida = 0;
+    if (longitud >= PROCESOPAR_UMBRAL_COMPRESION &&
+        comprimirPPLZ(mensaje, longitud, comprimido, longitud - 1, &longitudComprimida) == E_OK) {
+        cabecera.longitud = (uint32_t)longitudComprimida;
+        carga = comprimido;
+    }
+
+    return fwrite(&cabecera, sizeof(cabecera), 1, stdout) == 1 &&
+           fwrite(carga, 1, cabecera.longitud, stdout) == cabecera.longitud &&
+           fflush(stdout) == 0;
+}
+
+/**
+ * @brief Bucle con tramas: hasta EOF o una trama inválida
+ */
+static int atenderTramas(void) {
+    char *carga = NULL;
+    char *mensaje = NULL;
+    char *comprimido = NULL;
+    size_t capacidad = 0;
+    CabeceraTrama_t cabecera;
+
+    while (fread(&cabecera, sizeof(cabecera), 1, stdin) == 1) {
+        if (cabecera.longitud > PROCESOPAR_TRAMA_MAXIMA ||
+            cabecera.longitudOriginal > PROCESOPAR_TRAMA_MAXIMA) {
+            fprintf(stderr, "[HIJO PPLZ] Trama inválida\n");
+            break;
+        }
+
+        /* Un solo tamaño para todos los buffers: la respuesta lleva el prefijo */
+        size_t necesaria = PPLZ_CAPACIDAD_MAXIMA((size_t)cabecera.longitudOriginal + strlen(PREFIJO));
+        if (necesaria > capacidad) {
+            free(carga);
+            free(mensaje);
+            free(comprimido);
+            capacidad = necesaria;
+            carga = (char*)malloc(capacidad);
+            mensaje = (char*)malloc(capacidad);
+            comprimido = (char*)malloc(capacidad);
+            if (carga == NULL || mensaje == NULL || comprimido == NULL) {
+                break;
+            }
+        }
+
+        if (fread(carga, 1, cabecera.longitud, stdin) != cabecera.longitud) {
+            break;
+        }
+
+        /* La respuesta se construye directamente tras el prefijo */
+        int longitud = (int)cabecera.longitudOriginal;
+        memcpy(mensaje, PREFIJO, strlen(PREFIJO));
+        if (cabecera.longitud == cabecera.longitudOriginal) {
+            memcpy(mensaje + strlen(PREFIJO), carga, cabecera.longitud);
+        } else if (descomprimirPPLZ(carga, (int)cabecera.longitud, mensaje + strlen(PREFIJO),
+                                    longitud, &longitud) != E_OK ||
+                   longitud != (int)cabecera.longitudOriginal) {
+            fprintf(stderr, "[HIJO PPLZ] Carga comprimida inválida\n");
+            break;
+        }
+
+        if (!escribirTrama(mensaje, longitud + (int)strlen(PREFIJO), comprimido)) {
+            break;
+        }
+    }
+
+    free(carga);
+    free(mensaje);
+    free(comprimido);
+    return 0;
+}
+
+/**
+ * @brief Bucle sin tramas: una línea por mensaje
+ */
+static int atenderLineas(const char *primera) {
+    char linea[4096];
+
+    if (primera != NULL) {
+        printf(PREFIJO "%s", primera);
+        fflush(stdout);
+    }
+    while (fgets(linea, sizeof(linea), stdin) != NULL) {
+        printf(PREFIJO "%s", linea);
+        fflush(stdout);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *oferta = getenv(PROCESOPAR_VARIABLE_COMPRESION);
+    if (oferta == NULL || strcmp(oferta, PROCESOPAR_CODEC_COMPRESION) != 0) {
+        return atenderLineas(NULL);
+    }
+
+    /* Para probar el saludo tardío */
+    if (argc > 1) {
+        usleep((useconds_t)atoi(argv[1]) * 1000);
+    }
+
+    fputs(PROCESOPAR_SALUDO_COMPRESION, stdout);
+    fflush(stdout);
+
+    /* No pasar a tramas sin la aceptación del padre */
+    char primera[4096];
+    if (fgets(primera, sizeof(primera), stdin) == NULL) {
+        return 0;
+    }
+    if (strcmp(primera, PROCESOPAR_ACEPTACION_COMPRESION) == 0) {
+        fprintf(stderr, "[HIJO PPLZ] Compresión aceptada\n");
+        return atenderTramas();
+    }
+    return atenderLineas(primera);
+}
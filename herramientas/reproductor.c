@@ -0,0 +1,291 @@
+/**
+ * @file reproductor.c
+ * @brief Reproduce una captura de tráfico contra un hijo real y mide latencias
+ *
+ * Este programa (solo Linux):
+ * - Lee un archivo creado con iniciarCapturaProcesoPar()
+ * - Lanza el hijo indicado y le envía los mensajes capturados del padre,
+ *   a la velocidad original, escalada o lo más rápido posible
+ * - Empareja en orden cada envío con la respuesta correspondiente y
+ *   compara la distribución de latencias con la de la captura
+ *
+ * Uso: ./reproductor [-x factor] [-l] [-c] captura ejecutable [argumentos...]
+ *   -x factor  Velocidad relativa: 1 original (por defecto), 2 el doble, 0 sin esperas
+ *   -l         Mensajes del hijo separados por '\n' (opción delimitador)
+ *   -c         Ofrecer compresión PPLZ al hijo
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/ProcesoPar.h"
+
+/* Espera máxima a las respuestas que faltan tras el último envío */
+#define MS_ESPERA_FINAL 2000
+
+/* Mensaje del padre leído de la captura */
+typedef struct Envio {
+    unsigned long long ns;
+    const char *datos;
+    int longitud;
+} Envio_t;
+
+/* Instantes de llegada de las respuestas (los escribe la función de escucha) */
+static unsigned long long *llegadas;
+static int capacidadLlegadas;
+static int numLlegadas;
+
+static unsigned long long ahoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+static Estado_t funcionEscucha(const char *mensaje, int longitud) {
+    (void)mensaje;
+    (void)longitud;
+    int n = __atomic_load_n(&numLlegadas, __ATOMIC_RELAXED);
+    if (n < capacidadLlegadas) {
+        llegadas[n] = ahoraNs();
+        __atomic_store_n(&numLlegadas, n + 1, __ATOMIC_RELEASE);
+    }
+    return E_OK;
+}
+
+static int compararNs(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a;
+    unsigned long long y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Muestra percentiles de un array de latencias (lo ordena)
+ */
+static void mostrarLatencias(const char *nombre, unsigned long long *ns, int n) {
+    if (n == 0) {
+        printf("%-12s sin pares petición/respuesta\n", nombre);
+        return;
+    }
+    qsort(ns, (size_t)n, sizeof(*ns), compararNs);
+    printf("%-12s n %7d   p50 %8.1f us   p90 %8.1f us   p99 %8.1f us   p99.9 %8.1f us   max %9.1f us\n",
+           nombre, n,
+           ns[n / 2] / 1000.0,
+           ns[(long long)n * 9 / 10] / 1000.0,
+           ns[(long long)n * 99 / 100] / 1000.0,
+           ns[(long long)n * 999 / 1000] / 1000.0,
+           ns[n - 1] / 1000.0);
+}
+
+/**
+ * @brief Lee el archivo de captura entero
+ */
+static char *leerArchivo(const char *ruta, size_t *longitud) {
+    FILE *f = fopen(ruta, "rb");
+    if (f == NULL) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long tamano = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *datos = (tamano > 0) ? (char*)malloc((size_t)tamano) : NULL;
+    if (datos == NULL || fread(datos, 1, (size_t)tamano, f) != (size_t)tamano) {
+        free(datos);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *longitud = (size_t)tamano;
+    return datos;
+}
+
+static void uso(const char *programa) {
+    fprintf(stderr, "Uso: %s [-x factor] [-l] [-c] captura ejecutable [argumentos...]\n", programa);
+}
+
+int main(int argc, char *argv[]) {
+    double factor = 1.0;
+    int lineas = 0;
+    int compresion = 0;
+
+    int opcion;
+    while ((opcion = getopt(argc, argv, "+x:lc")) != -1) {
+        switch (opcion) {
+            case 'x': factor = atof(optarg); break;
+            case 'l': lineas = 1; break;
+            case 'c': compresion = 1; break;
+            default: uso(argv[0]); return 1;
+        }
+    }
+    if (argc - optind < 2 || factor < 0) {
+        uso(argv[0]);
+        return 1;
+    }
+    const char *rutaCaptura = argv[optind];
+    const char *ejecutable = argv[optind + 1];
+    const char **argumentos = (const char**)&argv[optind + 1];
+
+    /* 1. Leer la captura */
+    size_t tamano = 0;
+    char *captura = leerArchivo(rutaCaptura, &tamano);
+    CabeceraCaptura_t cabecera;
+    if (captura == NULL || tamano < sizeof(cabecera)) {
+        fprintf(stderr, "No se pudo leer %s\n", rutaCaptura);
+        return 1;
+    }
+    memcpy(&cabecera, captura, sizeof(cabecera));
+    if (memcmp(cabecera.magia, PROCESOPAR_MAGIA_CAPTURA, sizeof(cabecera.magia)) != 0 ||
+        cabecera.version != PROCESOPAR_VERSION_CAPTURA) {
+        fprintf(stderr, "%s no es una captura de ProcesoPar\n", rutaCaptura);
+        return 1;
+    }
+
+    /* Contar, separar envíos y recepciones */
+    int numEnvios = 0, numRecepciones = 0;
+    for (size_t p = sizeof(cabecera); p + sizeof(RegistroCaptura_t) <= tamano; ) {
+        RegistroCaptura_t r;
+        memcpy(&r, captura + p, sizeof(r));
+        if (p + sizeof(r) + r.longitud > tamano) {
+            break;
+        }
+        if (r.sentido == PROCESOPAR_CAPTURA_ENVIO) {
+            numEnvios++;
+        } else {
+            numRecepciones++;
+        }
+        p += sizeof(r) + r.longitud;
+    }
+
+    Envio_t *envios = (Envio_t*)malloc((size_t)(numEnvios + 1) * sizeof(Envio_t));
+    unsigned long long *recepcionesOriginales = (unsigned long long*)malloc((size_t)(numRecepciones + 1) * sizeof(unsigned long long));
+    unsigned long long *enviadosNs = (unsigned long long*)malloc((size_t)(numEnvios + 1) * sizeof(unsigned long long));
+    capacidadLlegadas = numRecepciones + numEnvios + 1;
+    llegadas = (unsigned long long*)malloc((size_t)capacidadLlegadas * sizeof(unsigned long long));
+    if (envios == NULL || recepcionesOriginales == NULL || enviadosNs == NULL || llegadas == NULL) {
+        fprintf(stderr, "Sin memoria\n");
+        return 1;
+    }
+
+    int e = 0, r = 0;
+    for (size_t p = sizeof(cabecera); p + sizeof(RegistroCaptura_t) <= tamano; ) {
+        RegistroCaptura_t registro;
+        memcpy(&registro, captura + p, sizeof(registro));
+        if (p + sizeof(registro) + registro.longitud > tamano) {
+            break;
+        }
+        if (registro.sentido == PROCESOPAR_CAPTURA_ENVIO) {
+            envios[e].ns = registro.ns;
+            envios[e].datos = captura + p + sizeof(registro);
+            envios[e].longitud = (int)registro.longitud;
+            e++;
+        } else {
+            recepcionesOriginales[r++] = registro.ns;
+        }
+        p += sizeof(registro) + registro.longitud;
+    }
+
+    printf("==============================================\n");
+    printf("  REPRODUCCIÓN DE %s\n", rutaCaptura);
+    printf("==============================================\n");
+    printf("Envíos: %d   Recepciones: %d   Velocidad: %s\n",
+           numEnvios, numRecepciones, factor > 0 ? "escalada" : "máxima");
+    if (factor > 0) {
+        printf("Factor: %.2fx\n", factor);
+    }
+    if (numEnvios == 0) {
+        return 0;
+    }
+
+    /* 2. Lanzar el hijo */
+    OpcionesProcesoPar_t opciones;
+    inicializarOpcionesProcesoPar(&opciones);
+    opciones.compresion = compresion;
+    if (lineas) {
+        opciones.delimitador = '\n';
+    }
+
+    ProcesoPar_t *pp = NULL;
+    Estado_t estado = lanzarProcesoParConOpciones(ejecutable, argumentos, &opciones, &pp);
+    if (estado != E_OK) {
+        fprintf(stderr, "No se pudo lanzar %s (código %u)\n", ejecutable, estado);
+        return 1;
+    }
+    if (establecerFuncionDeEscucha(pp, funcionEscucha) != E_OK) {
+        fprintf(stderr, "No se pudo crear el hilo de escucha\n");
+        destruirProcesoPar(pp);
+        return 1;
+    }
+
+    /* 3. Enviar con los intervalos originales divididos por el factor */
+    unsigned long long inicio = ahoraNs();
+    for (int i = 0; i < numEnvios; i++) {
+        if (factor > 0) {
+            unsigned long long objetivo = inicio +
+                (unsigned long long)((envios[i].ns - envios[0].ns) / factor);
+            struct timespec ts;
+            ts.tv_sec = (time_t)(objetivo / 1000000000ULL);
+            ts.tv_nsec = (long)(objetivo % 1000000000ULL);
+            /* Devuelve el error en vez de usar errno; solo EINTR se reintenta */
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+            }
+        }
+        enviadosNs[i] = ahoraNs();
+        if (enviarMensajeProcesoPar(pp, envios[i].datos, envios[i].longitud) != E_OK) {
+            fprintf(stderr, "Fallo al enviar el mensaje %d\n", i);
+            numEnvios = i;
+            break;
+        }
+    }
+    unsigned long long finEnvio = ahoraNs();
+
+    /* 4. Esperar las respuestas que faltan */
+    unsigned long long limite = ahoraNs() + MS_ESPERA_FINAL * 1000000ULL;
+    while (__atomic_load_n(&numLlegadas, __ATOMIC_ACQUIRE) < numRecepciones && ahoraNs() < limite) {
+        usleep(1000);
+    }
+    int recibidas = __atomic_load_n(&numLlegadas, __ATOMIC_ACQUIRE);
+    destruirProcesoPar(pp);
+
+    /* 5. Emparejar en orden y comparar */
+    int pares = (numEnvios < numRecepciones) ? numEnvios : numRecepciones;
+    unsigned long long *original = (unsigned long long*)malloc((size_t)(pares + 1) * sizeof(unsigned long long));
+    unsigned long long *reproducida = (unsigned long long*)malloc((size_t)(pares + 1) * sizeof(unsigned long long));
+    if (original == NULL || reproducida == NULL) {
+        fprintf(stderr, "Sin memoria\n");
+        return 1;
+    }
+
+    int nOriginal = 0, nReproducida = 0;
+    for (int i = 0; i < pares; i++) {
+        if (recepcionesOriginales[i] >= envios[i].ns) {
+            original[nOriginal++] = recepcionesOriginales[i] - envios[i].ns;
+        }
+        if (i < recibidas && llegadas[i] >= enviadosNs[i]) {
+            reproducida[nReproducida++] = llegadas[i] - enviadosNs[i];
+        }
+    }
+
+    /* numEnvios queda a 0 si falla el primer envío */
+    double segundosOriginal = (numEnvios > 0) ? (envios[numEnvios - 1].ns - envios[0].ns) / 1e9 : 0.0;
+    double segundosReproduccion = (finEnvio - inicio) / 1e9;
+    printf("Duración del envío: original %.3f s, reproducción %.3f s\n",
+           segundosOriginal, segundosReproduccion);
+    printf("Respuestas: esperadas %d, recibidas %d\n", numRecepciones, recibidas);
+    if (segundosReproduccion > 0) {
+        printf("Ritmo de envío: %.0f mensajes/s\n", numEnvios / segundosReproduccion);
+    }
+    mostrarLatencias("original", original, nOriginal);
+    mostrarLatencias("reproducida", reproducida, nReproducida);
+
+    free(original);
+    free(reproducida);
+    free(llegadas);
+    free(enviadosNs);
+    free(recepcionesOriginales);
+    free(envios);
+    free(captura);
+    return 0;
+}
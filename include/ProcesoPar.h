@@ -21,6 +21,14 @@
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Delimitadores que se localizan de una pasada sobre lo leído del hijo */
+#define PROCESOPAR_LIMITES_LOTE 64
 
 /* ============================================================================
  * DEFINICIÓN DE TIPOS
@@ -39,6 +47,78 @@ typedef unsigned int Estado_t;
  */
 typedef Estado_t (*FuncionEscucha_t)(const char *mensaje, int longitud);
 
+/**
+ * @brief Contadores de compresión de un proceso par
+ *
+ * Permiten decidir por carga de trabajo si compensa activar la compresión:
+ * la razón de compresión es bytesComprimidos / bytesOriginales y el coste
+ * de CPU son los nanosegundos acumulados en cada sentido.
+ */
+typedef struct EstadisticasCompresion {
+    unsigned long long mensajesComprimidos;       /* Mensajes enviados comprimidos */
+    unsigned long long mensajesSinComprimir;      /* Enviados sin comprimir (bajo umbral o no rentables) */
+    unsigned long long bytesOriginalesEnviados;   /* Bytes antes de comprimir (solo los comprimidos) */
+    unsigned long long bytesComprimidosEnviados;  /* Bytes escritos en la tubería tras comprimir */
+    unsigned long long mensajesDescomprimidos;    /* Mensajes recibidos comprimidos */
+    unsigned long long bytesComprimidosRecibidos; /* Bytes comprimidos leídos de la tubería */
+    unsigned long long bytesOriginalesRecibidos;  /* Bytes entregados tras descomprimir */
+    unsigned long long nsCompresion;              /* Tiempo de CPU comprimiendo (ns) */
+    unsigned long long nsDescompresion;           /* Tiempo de CPU descomprimiendo (ns) */
+} EstadisticasCompresion_t;
+
+/**
+ * @brief Opciones de lanzamiento de un proceso par
+ *
+ * Se inicializan con inicializarOpcionesProcesoPar() y se pasan a
+ * lanzarProcesoParConOpciones().
+ */
+typedef struct OpcionesProcesoPar {
+    int compresion;          /* 1 para ofrecer compresión PPLZ al hijo */
+    int umbralCompresion;    /* Tamaño mínimo (bytes) de un mensaje para comprimirlo */
+    int msNegociacion;       /* Tiempo máximo de espera del saludo del hijo (ms) */
+
+    /* Ubicación y planificación (solo Linux) */
+    const int *cpusHijo;     /* CPUs permitidas para el hijo (NULL: sin restricción) */
+    int numCpusHijo;         /* Elementos de cpusHijo */
+    const int *cpusEscucha;  /* CPUs permitidas para el hilo de escucha (NULL: sin restricción) */
+    int numCpusEscucha;      /* Elementos de cpusEscucha */
+    int nodoNuma;            /* Nodo NUMA cuyas CPUs se añaden a ambas listas (-1: ninguno) */
+    int nice;                /* Valor nice del hijo (PROCESOPAR_SIN_CAMBIO: heredar) */
+    int politica;            /* SCHED_OTHER, SCHED_FIFO, SCHED_RR, SCHED_BATCH... (-1: heredar) */
+    int prioridad;           /* Prioridad estática para SCHED_FIFO/SCHED_RR */
+    const char *cgroup;      /* Directorio de un cgroup ya creado para el hijo (NULL: ninguno) */
+
+    /* Separación de mensajes sin tramas */
+    int delimitador;         /* Byte que termina cada mensaje del hijo, p. ej. '\n' (-1: ninguno) */
+} OpcionesProcesoPar_t;
+
+/**
+ * @brief Contadores de la caché de respuestas de un proceso par
+ */
+typedef struct EstadisticasCache {
+    unsigned long long aciertos;      /* Llamadas respondidas desde la caché */
+    unsigned long long fallos;        /* Llamadas que tuvieron que ir al hijo */
+    unsigned long long agrupadas;     /* Llamadas que esperaron a otra idéntica en curso */
+    unsigned long long expulsiones;   /* Entradas expulsadas por falta de espacio */
+    unsigned long long caducadas;     /* Entradas descartadas por superar su vida */
+    unsigned long long entradas;      /* Entradas actuales */
+    unsigned long long bytes;         /* Bytes actuales (claves + respuestas) */
+} EstadisticasCache_t;
+
+/**
+ * @brief Cabecera de trama usada cuando se negocia la compresión
+ *
+ * Con compresión negociada, cada mensaje en ambos sentidos viaja como una
+ * cabecera seguida de `longitud` bytes. Si `longitud` es distinta de
+ * `longitudOriginal`, la carga útil va comprimida con el códec PPLZ.
+ * Los campos se escriben en el orden de bytes de la máquina, ya que ambos
+ * procesos se ejecutan en el mismo equipo.
+ */
+typedef struct CabeceraTrama {
+    uint32_t longitud;           /* Bytes de carga útil que siguen a la cabecera */
+    uint32_t longitudOriginal;   /* Bytes del mensaje una vez descomprimido */
+} CabeceraTrama_t;
+
 /**
  * @brief Estructura que representa un proceso par
  * 
@@ -60,13 +140,223 @@ typedef struct ProcesoPar {
         int pipeEntrada[2];           /* Tubería para leer desde el hijo: [0]=lectura, [1]=escritura */
         int pipeSalida[2];            /* Tubería para escribir al hijo: [0]=lectura, [1]=escritura */
         pthread_t hiloEscucha;        /* Hilo que escucha mensajes del proceso hijo */
+        int hiloCreado;               /* 1 si hiloEscucha debe esperarse al destruir */
+        pthread_mutex_t mutexEnvio;   /* Serializa la escritura de tramas */
+        int *cpusEscucha;             /* CPUs para el hilo de escucha (NULL: sin restricción) */
+        int numCpusEscucha;           /* Elementos de cpusEscucha */
+        int modoSondeo;               /* 1 si se recibe con recibirMensajesProcesoPar */
+        int finEntrada;               /* 1 si el hijo cerró su extremo de la tubería */
+        pthread_mutex_t mutexOrden;   /* Encola y envía cada llamada como un paso */
+        pthread_mutex_t mutexLlamadas; /* Protege la cola de llamadas y la caché */
+        pthread_cond_t condLlamadas;  /* Avisa de llamadas completadas */
+        struct LlamadaPendiente *primeraLlamada; /* Cola de llamadas sin respuesta */
+        struct LlamadaPendiente *ultimaLlamada;
+        struct CacheRespuestas *cache; /* Caché de respuestas, o NULL si no está activa */
+        struct CapturaProcesoPar *captura; /* Captura en curso, o NULL */
+        int usuariosCaptura;          /* Hilos que están escribiendo en la captura */
+        struct LatidoProcesoPar *latido; /* Latido activo, o NULL */
+        struct LanzamientoProcesoPar *lanzamiento; /* Copia de lo necesario para relanzar el hijo */
+        struct DiarioProcesoPar *diario; /* Diario de envíos, o NULL */
+        int usuariosDiario;           /* Hilos que están usando el diario */
+        int reenviandoDiario;         /* 1 mientras se relanza: el hilo de escucha lee aunque activo sea 0 */
     #endif
     
     /* === COMÚN A AMBOS SISTEMAS === */
     FuncionEscucha_t funcionEscucha;  /* Función callback para procesar mensajes */
     int activo;                       /* 1 si el proceso está activo, 0 si no */
+
+    /* === TRAMAS Y COMPRESIÓN === */
+    int compresion;                   /* 1 si el hijo aceptó la compresión PPLZ */
+    int umbralCompresion;             /* Mensajes más pequeños se envían sin comprimir */
+    int saludoTardio;                 /* 1 si un saludo de compresión tardío aún debe descartarse */
+    char *bufferEntrada;              /* Bytes leídos del hijo pendientes de entregar */
+    size_t capacidadEntrada;          /* Tamaño reservado de bufferEntrada */
+    size_t inicioEntrada;             /* Primer byte sin consumir de bufferEntrada */
+    size_t longitudEntrada;           /* Bytes válidos en bufferEntrada */
+    size_t posicionGuardada;          /* Byte sustituido por '\0' al entregar una trama */
+    char byteGuardado;                /* Valor original de ese byte */
+    int hayByteGuardado;              /* 1 si hay que restaurarlo */
+    int delimitador;                  /* Byte que termina cada mensaje sin tramas, o -1 */
+    size_t revisadoEntrada;           /* Bytes de bufferEntrada ya buscados (sus delimitadores están en limitesEntrada) */
+    uint32_t limitesEntrada[PROCESOPAR_LIMITES_LOTE]; /* Posiciones de delimitadores aún sin entregar */
+    int primerLimite;                 /* Siguiente posición de limitesEntrada por entregar */
+    int numLimites;                   /* Posiciones válidas en limitesEntrada */
+    char *bufferMensaje;              /* Destino de la descompresión */
+    size_t capacidadMensaje;          /* Tamaño reservado de bufferMensaje */
+    char *bufferEnvio;                /* Destino de la compresión */
+    size_t capacidadEnvio;            /* Tamaño reservado de bufferEnvio */
+    EstadisticasCompresion_t estadisticasCompresion;
+
+    /* === MUESTREO DE RECURSOS === */
+    struct MuestreoRecursos *muestreo; /* Estado del muestreador, o NULL si no está registrado */
+
+    /* === MEMORIA === */
+    struct BloqueProcesoPar *bloque;  /* Bloque compartido de un lote, o NULL si se reservó solo */
 } ProcesoPar_t;
 
+/**
+ * @brief Buffer proporcionado por quien llama para recibir un mensaje
+ *
+ * `datos` y `capacidad` (al menos 2) los rellena quien llama; `longitud` la rellena
+ * recibirMensajesProcesoPar(). Si una trama no cabe, se copian `capacidad`
+ * bytes y `longitud` indica el tamaño real.
+ */
+typedef struct MensajeRecibido {
+    char *datos;        /* Buffer de destino */
+    int capacidad;      /* Tamaño del buffer */
+    int longitud;       /* Salida: bytes del mensaje */
+} MensajeRecibido_t;
+
+/**
+ * @brief Muestra de consumo de recursos de un hijo
+ *
+ * Se obtiene de /proc/<pid>/stat, statm, io y status. Los contadores son
+ * acumulados desde que arrancó el hijo; milesimasCpu es el uso medio
+ * desde la muestra anterior.
+ */
+typedef struct MuestraRecursos {
+    unsigned long long ns;                    /* Instante (reloj monotónico) */
+    unsigned long long ticksCpu;              /* utime + stime (ticks de reloj) */
+    unsigned long long rssBytes;              /* Memoria residente */
+    unsigned long long bytesLeidos;           /* rchar: bytes leídos (incluye tuberías) */
+    unsigned long long bytesEscritos;         /* wchar: bytes escritos (incluye tuberías) */
+    unsigned long long cambiosVoluntarios;    /* Cambios de contexto voluntarios */
+    unsigned long long cambiosInvoluntarios;  /* Cambios de contexto involuntarios */
+    unsigned int milesimasCpu;                /* Uso de CPU: 1000 = un núcleo completo */
+} MuestraRecursos_t;
+
+/**
+ * @brief Función llamada cuando un recurso supera su umbral
+ *
+ * Se llama desde el hilo del muestreador al cruzar el umbral hacia arriba
+ * (una vez, hasta que el valor vuelva a bajar). No debe destruir el
+ * proceso par ni llamar a funciones de muestreo.
+ *
+ * @param procesoPar Proceso par que superó el umbral
+ * @param recurso PROCESOPAR_RECURSO_*
+ * @param valor Valor medido
+ */
+typedef void (*FuncionUmbral_t)(ProcesoPar_t *procesoPar, int recurso, unsigned long long valor);
+
+/**
+ * @brief Cabecera del archivo de captura
+ *
+ * Le sigue una secuencia de RegistroCaptura_t, cada uno seguido de sus
+ * `longitud` bytes de mensaje. Los enteros están en el orden de bytes de
+ * la máquina que capturó.
+ */
+typedef struct CabeceraCaptura {
+    char magia[4];               /* PROCESOPAR_MAGIA_CAPTURA */
+    uint32_t version;            /* PROCESOPAR_VERSION_CAPTURA */
+} CabeceraCaptura_t;
+
+/**
+ * @brief Registro de un mensaje capturado
+ */
+typedef struct RegistroCaptura {
+    uint64_t ns;                 /* Instante (reloj monotónico) */
+    uint32_t longitud;           /* Bytes del mensaje */
+    uint8_t sentido;             /* PROCESOPAR_CAPTURA_ENVIO o _RECEPCION */
+    uint8_t reservado[3];
+} RegistroCaptura_t;
+
+/**
+ * @brief Especificación de un proceso par dentro de un lanzamiento por lotes
+ *
+ * Los tres primeros campos los rellena quien llama; procesoPar y estado
+ * los rellena lanzarLoteProcesoPar().
+ */
+typedef struct EspecificacionProcesoPar {
+    const char *nombreArchivoEjecutable;  /* Ruta o nombre del ejecutable */
+    const char **listaLineaComando;       /* Argumentos terminados en NULL */
+    const OpcionesProcesoPar_t *opciones; /* NULL para los valores por defecto */
+    ProcesoPar_t *procesoPar;             /* Salida: proceso par creado, o NULL */
+    Estado_t estado;                      /* Salida: resultado de este lanzamiento */
+} EspecificacionProcesoPar_t;
+
+/**
+ * @brief Grupo de procesos pares equivalentes que se reparten el tráfico
+ *
+ * Estructura opaca: se crea con crearGrupoProcesoPar() y se libera con
+ * destruirGrupoProcesoPar().
+ */
+typedef struct GrupoProcesoPar GrupoProcesoPar_t;
+
+/**
+ * @brief Cómo se sustituye un proceso par por otro sin cortar el servicio
+ *
+ * Los campos a 0 (o NULL) toman el valor por defecto.
+ */
+typedef struct OpcionesReemplazo {
+    const char *mensajeListo;  /* Mensaje con el que el hijo anuncia que está listo (NULL: no esperar) */
+    int longitudListo;         /* Bytes de mensajeListo */
+    int msListo;               /* Espera máxima del mensaje de listo (0: PROCESOPAR_MS_LISTO) */
+    int msDrenaje;             /* Plazo para que el hijo retirado termine lo pendiente (0: PROCESOPAR_MS_DRENAJE) */
+    int exceso;                /* Hijos nuevos que un grupo lanza por encima de su tamaño (0: 1) */
+} OpcionesReemplazo_t;
+
+/**
+ * @brief Función llamada cuando un proceso par deja de responder al latido
+ *
+ * Se llama desde el hilo de latidos al declarar atascado al hijo (una vez,
+ * hasta que vuelva a responder o se relance), antes de relanzarlo si así
+ * se pidió. No debe destruir el proceso par ni llamar a funciones de latido.
+ *
+ * @param procesoPar Proceso par atascado
+ * @param msSinRespuesta Tiempo desde que se recibió algo del hijo por última vez
+ */
+typedef void (*FuncionLatido_t)(ProcesoPar_t *procesoPar, unsigned long long msSinRespuesta);
+
+/**
+ * @brief Cómo se vigila que un proceso par siga respondiendo
+ *
+ * Los campos a 0 (o NULL) toman el valor por defecto.
+ */
+typedef struct OpcionesLatido {
+    const char *sonda;         /* Mensaje que se envía al hijo (NULL: PROCESOPAR_SONDA_LATIDO) */
+    int longitudSonda;         /* Bytes de sonda */
+    const char *respuesta;     /* Mensaje con el que responde el hijo (NULL: igual que la sonda) */
+    int longitudRespuesta;     /* Bytes de respuesta */
+    int msIntervalo;           /* Silencio tras el que se envía una sonda (0: PROCESOPAR_MS_LATIDO) */
+    int fallosMaximos;         /* Sondas seguidas sin respuesta para declararlo atascado (0: PROCESOPAR_FALLOS_LATIDO) */
+    FuncionLatido_t funcion;   /* Aviso al declararlo atascado (NULL: ninguno) */
+    int relanzar;              /* 1 para matar al hijo atascado y lanzarlo de nuevo */
+} OpcionesLatido_t;
+
+/**
+ * @brief Estado del latido de un proceso par
+ */
+typedef struct EstadoLatido {
+    unsigned long long msSinRespuesta;     /* Desde lo último recibido del hijo (con la precisión del intervalo) */
+    unsigned long long usUltimaRespuesta;  /* Lo que tardó en llegar la última respuesta a una sonda (0: ninguna) */
+    unsigned long long sondas;             /* Sondas enviadas */
+    unsigned long long relanzamientos;     /* Veces que se relanzó el hijo */
+    int fallos;                            /* Sondas seguidas sin respuesta */
+    int atascado;                          /* 1 si está declarado atascado */
+} EstadoLatido_t;
+
+/**
+ * @brief Cómo se guarda en disco lo enviado a un proceso par
+ *
+ * Los campos a 0 toman el valor por defecto.
+ */
+typedef struct OpcionesDiario {
+    size_t bytesSegmento;      /* Tamaño de cada archivo del diario (0: PROCESOPAR_DIARIO_BYTES) */
+    int msSincronizacion;      /* Periodo de msync (0: PROCESOPAR_MS_DIARIO) */
+    int confirmarRespuestas;   /* 1: cada mensaje del hijo confirma el mensaje enviado más antiguo */
+} OpcionesDiario_t;
+
+/**
+ * @brief Estado del diario de un proceso par
+ */
+typedef struct EstadoDiario {
+    unsigned long long ultimaSecuencia;   /* Secuencia del último mensaje anotado (0: ninguno) */
+    unsigned long long confirmada;        /* Confirmados todos los mensajes hasta esta secuencia */
+    unsigned long long segmentos;         /* Archivos del diario en disco */
+    unsigned long long sincronizaciones;  /* Llamadas a msync */
+    unsigned long long reenviados;        /* Mensajes reenviados al activar o relanzar */
+} EstadoDiario_t;
+
 /* ============================================================================
  * CÓDIGOS DE ESTADO
  * ============================================================================ */
@@ -79,6 +369,91 @@ typedef struct ProcesoPar {
 #define E_ENVIO_FALLO   5    /* Error al enviar mensaje */
 #define E_PROCESO_INACT 6    /* El proceso no está activo */
 #define E_CREAR_HILO    7    /* Error al crear hilo de escucha */
+#define E_NO_SOPORTADO  8    /* Operación no disponible en este sistema */
+#define E_DATOS_CORRUPTOS 9  /* Trama o bloque comprimido mal formado */
+#define E_UBICACION     10   /* No se pudo aplicar afinidad, planificación o cgroup */
+#define E_MODO          11   /* Incompatible con el modo de recepción en uso */
+#define E_TIEMPO        12   /* Tiempo de espera agotado */
+
+/* ============================================================================
+ * UBICACIÓN EN CPUs Y NODOS NUMA
+ * ============================================================================ */
+
+/* Valor de OpcionesProcesoPar_t.nice para no modificar la prioridad heredada */
+#define PROCESOPAR_SIN_CAMBIO  (-1000)
+
+/* Recursos vigilables con establecerUmbralRecursos() */
+#define PROCESOPAR_RECURSO_RSS  0   /* Memoria residente en bytes */
+#define PROCESOPAR_RECURSO_CPU  1   /* Uso de CPU en milésimas de núcleo */
+#define PROCESOPAR_RECURSO_ES   2   /* Bytes leídos + escritos por segundo */
+#define PROCESOPAR_NUM_RECURSOS 3
+
+/* Muestras que guarda cada proceso par si no se indica otra cosa */
+#define PROCESOPAR_MUESTRAS_DEFECTO 256
+
+/* Modos de calcularUbicacionProcesoPar() */
+#define PROCESOPAR_UBICACION_DISPERSA  0   /* Alternar nodos: reparte caché y memoria */
+#define PROCESOPAR_UBICACION_COMPACTA  1   /* Llenar un nodo antes del siguiente */
+
+/* Memoria y vida por defecto de la caché de respuestas */
+#define PROCESOPAR_CACHE_BYTES  (4 * 1024 * 1024)
+#define PROCESOPAR_CACHE_MS     1000
+
+/* Plazos por defecto de OpcionesReemplazo_t */
+#define PROCESOPAR_MS_LISTO    5000
+#define PROCESOPAR_MS_DRENAJE  5000
+
+/* Valores por defecto de OpcionesLatido_t */
+#define PROCESOPAR_SONDA_LATIDO   "PPLATIDO\n"
+#define PROCESOPAR_MS_LATIDO      1000
+#define PROCESOPAR_FALLOS_LATIDO  3
+
+/* Valores por defecto de OpcionesDiario_t y formato de sus archivos */
+#define PROCESOPAR_DIARIO_BYTES   (16 * 1024 * 1024)
+#define PROCESOPAR_MS_DIARIO      100
+#define PROCESOPAR_MAGIA_DIARIO   "PPDI"
+#define PROCESOPAR_VERSION_DIARIO 1
+
+/* ============================================================================
+ * CAPTURA DE TRÁFICO
+ * ============================================================================ */
+
+#define PROCESOPAR_MAGIA_CAPTURA   "PPCA"
+#define PROCESOPAR_VERSION_CAPTURA 1
+
+/* Sentido de un mensaje capturado */
+#define PROCESOPAR_CAPTURA_ENVIO     0   /* Del padre al hijo */
+#define PROCESOPAR_CAPTURA_RECEPCION 1   /* Del hijo al padre */
+
+/* Tamaño por defecto del anillo de captura de cada proceso par */
+#define PROCESOPAR_CAPTURA_BYTES (4 * 1024 * 1024)
+
+/* ============================================================================
+ * COMPRESIÓN PPLZ
+ * ============================================================================ */
+
+/* Variable de entorno con la que el padre ofrece la compresión al hijo */
+#define PROCESOPAR_VARIABLE_COMPRESION "PROCESOPAR_COMPRESION"
+
+/* Valor de la variable y saludo con el que el hijo acepta la oferta.
+ * El hijo que acepta debe escribir el saludo en stdout antes que nada y
+ * esperar la primera línea de stdin. Si es PROCESOPAR_ACEPTACION_COMPRESION,
+ * a partir de ahí lee y escribe tramas (CabeceraTrama_t + carga útil); si
+ * no, el padre no recibió el saludo a tiempo: la línea es el primer mensaje
+ * y el hijo sigue sin tramas. examples/hijo_pplz.c es un hijo de referencia. */
+#define PROCESOPAR_CODEC_COMPRESION "PPLZ1"
+#define PROCESOPAR_SALUDO_COMPRESION "PPLZ1\n"
+#define PROCESOPAR_ACEPTACION_COMPRESION "PPLZ1 OK\n"
+
+/* Valores por defecto de OpcionesProcesoPar_t */
+#define PROCESOPAR_UMBRAL_COMPRESION  512
+#define PROCESOPAR_MS_NEGOCIACION     250
+
+/* Tamaño máximo de una trama aceptada desde el hijo */
+#define PROCESOPAR_TRAMA_MAXIMA (64 * 1024 * 1024)
+
+/* Capacidad de destino suficiente para comprimir n bytes en el peor caso */
+#define PPLZ_CAPACIDAD_MAXIMA(n) ((n) + (n) / 255 + 16)
 
 /* ============================================================================
  * PROTOTIPOS DE FUNCIONES
@@ -88,6 +463,11 @@ typedef struct ProcesoPar {
  * @brief Lanza un nuevo proceso par (proceso hijo)
  * 
  * Crea un proceso hijo y establece comunicación bidireccional mediante tuberías.
+ *
+ * En Linux, escribir a un hijo muerto devuelve E_ENVIO_FALLO en vez de
+ * terminar el proceso: SIGPIPE se bloquea solo en el hilo que escribe y
+ * mientras dura la escritura, y se descarta el que esta provoque. La acción
+ * de SIGPIPE del proceso no cambia.
  * 
  * @param nombreArchivoEjecutable Ruta al ejecutable del proceso hijo
  * @param listaLineaComando Array de argumentos (terminado en NULL). El primer
@@ -108,13 +488,102 @@ Estado_t lanzarProcesoPar(
     ProcesoPar_t **procesoPar
 );
 
+/**
+ * @brief Inicializa unas opciones de lanzamiento con los valores por defecto
+ *
+ * @param opciones Puntero a la estructura a inicializar
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t inicializarOpcionesProcesoPar(OpcionesProcesoPar_t *opciones);
+
+/**
+ * @brief Lanza un nuevo proceso par con opciones de lanzamiento
+ *
+ * Igual que lanzarProcesoPar(), pero permite negociar la compresión PPLZ.
+ * Si opciones->compresion vale 1, el hijo recibe la variable de entorno
+ * PROCESOPAR_COMPRESION=PPLZ1 y el padre espera hasta msNegociacion ms el
+ * saludo PROCESOPAR_SALUDO_COMPRESION, al que responde con
+ * PROCESOPAR_ACEPTACION_COMPRESION. Si el hijo no lo envía a tiempo, el
+ * proceso par queda en modo sin tramas, exactamente como con
+ * lanzarProcesoPar(); un saludo tardío se descarta y no llega como mensaje.
+ *
+ * @param nombreArchivoEjecutable Ruta al ejecutable del proceso hijo
+ * @param listaLineaComando Array de argumentos (terminado en NULL)
+ * @param opciones Opciones de lanzamiento (NULL equivale a los valores por defecto)
+ * @param procesoPar Puntero a puntero donde se almacenará la estructura creada
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t lanzarProcesoParConOpciones(
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    ProcesoPar_t **procesoPar
+);
+
+/**
+ * @brief Lanza muchos procesos pares a la vez
+ *
+ * Reparte los lanzamientos entre varios hilos. Cada ejecutable distinto se
+ * resuelve una sola vez (búsqueda en PATH incluida) y los hijos se ejecutan
+ * desde un descriptor O_PATH con execveat, sin repetir la búsqueda. Todas
+ * las estructuras ProcesoPar_t se reservan en un único bloque contiguo; cada
+ * una se destruye igualmente con destruirProcesoPar() y el bloque se libera
+ * al destruir la última.
+ *
+ * @param especificaciones Array de especificaciones (se rellenan procesoPar y estado)
+ * @param numero Número de elementos del array
+ * @param numHilos Hilos lanzadores (0 o negativo: elegir automáticamente)
+ * @param nsTotales Si no es NULL, recibe el tiempo total del lote en nanosegundos
+ * @return Estado_t E_OK si todos se lanzaron, o el código del primer fallo
+ */
+Estado_t lanzarLoteProcesoPar(
+    EspecificacionProcesoPar_t *especificaciones,
+    int numero,
+    int numHilos,
+    unsigned long long *nsTotales
+);
+
+/**
+ * @brief Calcula la CPU y el nodo NUMA del par número `indice` de un grupo
+ *
+ * Lee la topología de /sys/devices/system/node la primera vez que se usa y
+ * la guarda para el resto del proceso. En modo disperso los pares
+ * consecutivos caen en nodos distintos; en modo compacto se llenan primero
+ * las CPUs de un nodo. El resultado sirve para rellenar cpusHijo/cpusEscucha
+ * o nodoNuma de las opciones de lanzamiento.
+ *
+ * @param indice Posición del par dentro del grupo (desde 0)
+ * @param modo PROCESOPAR_UBICACION_DISPERSA o PROCESOPAR_UBICACION_COMPACTA
+ * @param cpu Recibe la CPU asignada
+ * @param nodo Si no es NULL, recibe el nodo NUMA de esa CPU
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t calcularUbicacionProcesoPar(int indice, int modo, int *cpu, int *nodo);
+
+/**
+ * @brief Vuelca las trazas registradas a un archivo en formato Chrome trace
+ *
+ * Solo disponible si la biblioteca se compiló con `make TRAZAS=1`; el
+ * archivo se abre con chrome://tracing o Perfetto. Cada hilo (el que envía,
+ * el de escucha...) aparece por separado con sus intervalos de envío y de
+ * función de escucha y los instantes de lectura, despacho, lanzamiento y
+ * destrucción.
+ *
+ * @param rutaArchivo Archivo JSON a crear
+ * @return Estado_t E_OK, o E_NO_SOPORTADO si las trazas no están compiladas
+ */
+Estado_t volcarTrazasProcesoPar(const char *rutaArchivo);
+
 /**
  * @brief Destruye un proceso par
  * 
  * Termina el proceso hijo, cierra todas las tuberías y libera recursos.
+ * No puede llamarse desde la función de escucha del propio proceso par: el
+ * hilo de escucha sigue usando sus buffers al volver de ella.
  * 
  * @param procesoPar Puntero a la estructura del proceso par
- * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ * @return Estado_t E_OK si tiene éxito; E_MODO si se llama desde su hilo
+ *         de escucha; código de error en caso contrario
  */
 Estado_t destruirProcesoPar(ProcesoPar_t *procesoPar);
 
@@ -157,4 +626,525 @@ Estado_t establecerFuncionDeEscucha(
     Estado_t (*f)(const char *, int)
 );
 
+/**
+ * @brief Obtiene el descriptor del que se leen los mensajes del hijo
+ *
+ * Pasa el proceso par a modo de sondeo: el descriptor queda no bloqueante
+ * para integrarlo en un bucle de eventos propio (poll, epoll, select...) y
+ * los mensajes se leen con recibirMensajesProcesoPar(). En este modo no se
+ * puede establecer una función de escucha. Solo Linux.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param descriptor Recibe el descriptor de lectura
+ * @return Estado_t E_OK, E_MODO si ya hay hilo de escucha, o E_NO_SOPORTADO
+ */
+Estado_t obtenerDescriptorLecturaProcesoPar(ProcesoPar_t *procesoPar, int *descriptor);
+
+/**
+ * @brief Recibe sin bloquear los mensajes ya disponibles del hijo
+ *
+ * Lee todo lo que haya en la tubería y copia hasta `maximo` mensajes en los
+ * buffers proporcionados, sin crear ningún hilo. Sin tramas, cada mensaje
+ * es un bloque de lo leído (partido si no cabe en el buffer), salvo que el
+ * proceso par tenga delimitador: entonces es una línea completa. Pasa el
+ * proceso par a modo de sondeo si aún no lo estaba. No es seguro llamarla
+ * desde varios hilos a la vez para el mismo proceso par.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param mensajes Buffers de destino
+ * @param maximo Número de buffers
+ * @param recibidos Recibe el número de mensajes copiados (puede ser 0)
+ * @return Estado_t E_OK; E_PROCESO_INACT si el hijo cerró y no queda nada;
+ *         E_DATOS_CORRUPTOS si llega una trama inválida
+ */
+Estado_t recibirMensajesProcesoPar(
+    ProcesoPar_t *procesoPar,
+    MensajeRecibido_t *mensajes,
+    int maximo,
+    int *recibidos
+);
+
+/**
+ * @brief Espera a que haya algún mensaje listo para recibirMensajesProcesoPar()
+ *
+ * Primero sondea activamente durante `usGiro` microsegundos (sin ceder la
+ * CPU, para la latencia mínima) y después se bloquea en poll() hasta
+ * `msEspera` milisegundos (-1 para esperar indefinidamente).
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param usGiro Presupuesto de sondeo activo en microsegundos (0: ninguno)
+ * @param msEspera Espera bloqueante posterior en milisegundos
+ * @return Estado_t E_OK si hay mensaje, E_TIEMPO si no llegó ninguno,
+ *         E_PROCESO_INACT si el hijo cerró la tubería
+ */
+Estado_t esperarMensajesProcesoPar(ProcesoPar_t *procesoPar, int usGiro, int msEspera);
+
+/**
+ * @brief Envía una petición y espera la respuesta del hijo
+ *
+ * Supone un protocolo de petición/respuesta: el hijo contesta cada
+ * petición con exactamente un mensaje y en el mismo orden. Para que los
+ * mensajes sin tramas tengan límites fiables, lance el proceso par con
+ * `delimitador` (p. ej. '\n') o con compresión. Si no hay hilo de escucha,
+ * se crea uno sin función de escucha; las respuestas se entregan a quien
+ * llamó y la función de escucha solo recibe los mensajes sin llamada
+ * pendiente. No mezcle llamadas con enviarMensajeProcesoPar() si este
+ * también provoca respuestas. Solo Linux.
+ *
+ * Con la caché activa (activarCacheProcesoPar()), una llamada con la misma
+ * clave se responde sin ir al hijo mientras la entrada no caduque, y las
+ * llamadas idénticas simultáneas esperan a la primera en vez de repetirla.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param peticion Mensaje a enviar
+ * @param longitud Longitud de la petición en bytes
+ * @param clave Clave de caché (NULL: los bytes de la petición)
+ * @param longitudClave Longitud de la clave en bytes
+ * @param respuesta Buffer de la respuesta (como en recibirMensajesProcesoPar())
+ * @param msEspera Tiempo máximo de espera en milisegundos (-1: sin límite)
+ * @return Estado_t E_OK; E_TIEMPO si no llegó a tiempo (la respuesta tardía
+ *         se descarta, o se guarda en la caché); E_MODO en modo de sondeo;
+ *         E_PROCESO_INACT si el hijo cerró la tubería
+ */
+Estado_t llamarProcesoPar(
+    ProcesoPar_t *procesoPar,
+    const char *peticion,
+    int longitud,
+    const char *clave,
+    int longitudClave,
+    MensajeRecibido_t *respuesta,
+    int msEspera
+);
+
+/**
+ * @brief Activa (o reconfigura) la caché de respuestas de llamarProcesoPar()
+ *
+ * Las entradas se expulsan por orden de uso (LRU) al superar `bytesMaximos`
+ * y se descartan al cumplir `msVida`. Solo debe usarse con peticiones
+ * idempotentes. Reconfigurar vacía la caché pero conserva los contadores.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param bytesMaximos Memoria máxima de claves y respuestas (0: PROCESOPAR_CACHE_BYTES)
+ * @param msVida Vida de cada entrada en milisegundos (0: PROCESOPAR_CACHE_MS)
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t activarCacheProcesoPar(ProcesoPar_t *procesoPar, size_t bytesMaximos, int msVida);
+
+/**
+ * @brief Obtiene los contadores de la caché de respuestas
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param estadisticas Estructura donde se copian los contadores
+ * @return Estado_t E_OK, o E_PAR_INC si la caché no está activa
+ */
+Estado_t obtenerEstadisticasCache(ProcesoPar_t *procesoPar, EstadisticasCache_t *estadisticas);
+
+/**
+ * @brief Sustituye el hijo de un proceso par por uno nuevo sin cortar el servicio
+ *
+ * Lanza el nuevo ejecutable junto al actual y, si se indicó mensajeListo,
+ * espera a que el nuevo hijo lo envíe (se consume y no llega a nadie). Solo
+ * entonces *procesoPar pasa a apuntar al nuevo proceso par y la función
+ * vuelve. El anterior se drena en un hilo aparte: se cierra su entrada
+ * estándar para que termine lo que tenga en curso, y sus respuestas siguen
+ * llegando a su función de escucha y a sus llamadas pendientes. Al salir el
+ * hijo, o al cumplirse msDrenaje (con SIGKILL si aún vive), se destruye. Si
+ * el nuevo hijo no llega a estar listo, se destruye y *procesoPar no cambia.
+ *
+ * Quien llama debe ser el único dueño de *procesoPar: el proceso par
+ * anterior pasa al hilo de drenaje, que lo libera en cualquier momento, así
+ * que ningún otro hilo puede estar usándolo ni conservar una copia del
+ * puntero. No se lleva la cuenta de sus usos en curso; para repartir el
+ * tráfico entre hilos y reemplazar sin cortar, use un grupo
+ * (actualizarGrupoProcesoPar). Sin delimitador ni compresión, mensajeListo
+ * se compara con los primeros bytes que escribe el hijo. Solo Linux.
+ *
+ * @param procesoPar Proceso par a sustituir; recibe el nuevo
+ * @param nombreArchivoEjecutable Ruta al nuevo ejecutable
+ * @param listaLineaComando Argumentos (terminados en NULL)
+ * @param opciones Opciones de lanzamiento del nuevo hijo (NULL: por defecto)
+ * @param reemplazo Mensaje de listo y plazos (NULL: por defecto)
+ * @return Estado_t E_OK; E_TIEMPO si el nuevo hijo no anunció que estaba
+ *         listo; E_DATOS_CORRUPTOS si envió otra cosa; E_MODO en modo de sondeo
+ */
+Estado_t reemplazarProcesoPar(
+    ProcesoPar_t **procesoPar,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    const OpcionesReemplazo_t *reemplazo
+);
+
+/**
+ * @brief Crea un grupo de procesos pares iguales
+ *
+ * Lanza los hijos con lanzarLoteProcesoPar() y, si reemplazo indica
+ * mensajeListo, espera el de cada uno. Solo Linux.
+ *
+ * @param nombreArchivoEjecutable Ruta al ejecutable
+ * @param listaLineaComando Argumentos (terminados en NULL)
+ * @param opciones Opciones de lanzamiento de cada hijo (NULL: por defecto)
+ * @param reemplazo Mensaje de listo (NULL: no esperar)
+ * @param numero Procesos pares del grupo
+ * @param grupo Recibe el grupo creado
+ * @return Estado_t E_OK, o el código del primer fallo (no se crea nada)
+ */
+Estado_t crearGrupoProcesoPar(
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    const OpcionesReemplazo_t *reemplazo,
+    int numero,
+    GrupoProcesoPar_t **grupo
+);
+
+/**
+ * @brief Envía un mensaje al siguiente proceso par del grupo (por turnos)
+ *
+ * @param grupo Grupo de destino
+ * @param mensaje Mensaje a enviar
+ * @param longitud Longitud del mensaje en bytes
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t enviarGrupoProcesoPar(GrupoProcesoPar_t *grupo, const char *mensaje, int longitud);
+
+/**
+ * @brief Llama con llamarProcesoPar() al siguiente proceso par del grupo (por turnos)
+ *
+ * Los parámetros y el resultado son los de llamarProcesoPar().
+ */
+Estado_t llamarGrupoProcesoPar(
+    GrupoProcesoPar_t *grupo,
+    const char *peticion,
+    int longitud,
+    const char *clave,
+    int longitudClave,
+    MensajeRecibido_t *respuesta,
+    int msEspera
+);
+
+/**
+ * @brief Sustituye todos los procesos pares del grupo por un nuevo ejecutable
+ *
+ * Reemplaza por tandas de `exceso` hijos: lanza la tanda nueva, espera su
+ * mensaje de listo, la añade al reparto y solo entonces saca del reparto
+ * otros tantos hijos antiguos, que se drenan como en reemplazarProcesoPar()
+ * (los envíos y llamadas ya en curso en ellos terminan primero). El grupo
+ * nunca atiende con menos hijos de los que tenía. Puede usarse mientras
+ * otros hilos envían y llaman al grupo. Si una tanda falla, se detiene con
+ * el grupo completo, mezclando hijos nuevos y antiguos.
+ *
+ * @param grupo Grupo a actualizar
+ * @param nombreArchivoEjecutable Ruta al nuevo ejecutable
+ * @param listaLineaComando Argumentos (terminados en NULL)
+ * @param opciones Opciones de lanzamiento de los nuevos hijos (NULL: por defecto)
+ * @param reemplazo Mensaje de listo, plazos y exceso (NULL: por defecto)
+ * @return Estado_t E_OK, o el código del fallo de la tanda que no pudo lanzarse
+ */
+Estado_t actualizarGrupoProcesoPar(
+    GrupoProcesoPar_t *grupo,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    const OpcionesReemplazo_t *reemplazo
+);
+
+/**
+ * @brief Destruye todos los procesos pares del grupo y libera el grupo
+ *
+ * Ningún hilo debe estar usando el grupo.
+ *
+ * @param grupo Grupo a destruir
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t destruirGrupoProcesoPar(GrupoProcesoPar_t *grupo);
+
+/**
+ * @brief Activa (o reconfigura) la vigilancia por latido de un proceso par
+ *
+ * Un hijo bloqueado mantiene abiertas sus tuberías, así que nada indica que
+ * ha dejado de atender. Con el latido, cada vez que el hijo pasa
+ * msIntervalo sin enviar nada se le envía la sonda; todo mensaje recibido
+ * cuenta como respuesta, y los que son exactamente `respuesta` se consumen
+ * sin llegar a llamadas ni a la función de escucha. Tras fallosMaximos
+ * sondas seguidas sin respuesta, el proceso par se declara atascado: se
+ * llama a la función de aviso y, si se pidió, el hijo se mata con SIGKILL
+ * (sus llamadas pendientes fallan con E_PROCESO_INACT) y se lanza otro con
+ * el mismo ejecutable, argumentos y opciones. El proceso par conserva su
+ * dirección, su función de escucha y su caché.
+ *
+ * Un único hilo vigila todos los procesos pares con una rueda de
+ * temporizadores sobre un timerfd: activar, vencer y desactivar un latido
+ * cuestan O(1) con independencia de cuántos haya. Una llamada que tarde más
+ * de msIntervalo * fallosMaximos en responder se confunde con un atasco.
+ * destruirProcesoPar() desactiva el latido automáticamente. Solo Linux.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param opciones Sonda, respuesta, plazos y acciones (NULL: por defecto)
+ * @return Estado_t E_OK; E_MODO en modo de sondeo
+ */
+Estado_t activarLatidoProcesoPar(ProcesoPar_t *procesoPar, const OpcionesLatido_t *opciones);
+
+/**
+ * @brief Deja de vigilar un proceso par por latido
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t desactivarLatidoProcesoPar(ProcesoPar_t *procesoPar);
+
+/**
+ * @brief Obtiene el estado del latido de un proceso par
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param estado Estructura donde se copia el estado
+ * @return Estado_t E_OK, o E_PAR_INC si el latido no está activo
+ */
+Estado_t obtenerEstadoLatido(ProcesoPar_t *procesoPar, EstadoLatido_t *estado);
+
+/**
+ * @brief Activa el modo duradero: cada mensaje enviado se anota antes en un diario
+ *
+ * enviarMensajeProcesoPar() (y con él llamarProcesoPar()) copia cada
+ * mensaje, con un número de secuencia creciente, en un archivo del
+ * directorio proyectado en memoria, antes de escribirlo en la tubería.
+ * Anotar y escribir van juntos bajo el cerrojo de envío, así que las
+ * secuencias siguen el orden de la tubería aun con varios hilos enviando
+ * (también sin tramas): los envíos duraderos se serializan, y la anotación
+ * es una copia en memoria sin llamadas al sistema. Un hilo del
+ * diario pasa lo anotado a disco con msync cada msSincronizacion, prepara
+ * el siguiente archivo cuando el actual se llena y borra los archivos cuyos
+ * mensajes están todos confirmados. Un fallo del proceso padre pierde como
+ * mucho lo anotado en el último periodo si cae el sistema, y nada si solo
+ * cae el proceso.
+ *
+ * Los mensajes se confirman en orden: con confirmarRespuestas, cada mensaje
+ * recibido del hijo confirma el más antiguo sin confirmar (hijos que
+ * responden una vez a cada mensaje); si no, con confirmarDiarioProcesoPar().
+ * Lo no confirmado se reenvía al hijo al activar el diario sobre un
+ * directorio que ya lo tenía (p. ej. tras reiniciar el padre) y cada vez que
+ * el latido relanza al hijo, así que la entrega es al menos una vez.
+ *
+ * El directorio es de un solo proceso par; se crea si no existe. Al
+ * relanzar, los envíos nuevos fallan con E_PROCESO_INACT hasta terminar el
+ * reenvío, y nunca se adelantan a lo reenviado. Si la escritura en la tubería falla, el
+ * mensaje sigue anotado y se reenviará: no lo envíe de nuevo. Un mensaje
+ * que no cabe en un archivo del diario no se envía (E_ENVIO_FALLO).
+ * destruirProcesoPar() cierra el diario y conserva sus archivos. Solo Linux.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param directorio Directorio del diario
+ * @param opciones Tamaño de los archivos, periodo de msync y confirmación (NULL: por defecto)
+ * @return Estado_t E_OK; E_DATOS_CORRUPTOS si el directorio tiene archivos
+ *         de diario inválidos; E_MODO en modo de sondeo
+ */
+Estado_t activarDiarioProcesoPar(
+    ProcesoPar_t *procesoPar,
+    const char *directorio,
+    const OpcionesDiario_t *opciones
+);
+
+/**
+ * @brief Confirma que el hijo ya procesó todos los mensajes hasta una secuencia
+ *
+ * El primer mensaje anotado en un diario nuevo tiene la secuencia 1 y cada
+ * envío suma uno; la última asignada está en EstadoDiario_t.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param secuencia Último mensaje confirmado
+ * @return Estado_t E_OK, o E_PAR_INC si no hay diario o la secuencia no se ha asignado
+ */
+Estado_t confirmarDiarioProcesoPar(ProcesoPar_t *procesoPar, unsigned long long secuencia);
+
+/**
+ * @brief Obtiene el estado del diario de un proceso par
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param estado Estructura donde se copia el estado
+ * @return Estado_t E_OK, o E_PAR_INC si el diario no está activo
+ */
+Estado_t obtenerEstadoDiario(ProcesoPar_t *procesoPar, EstadoDiario_t *estado);
+
+/**
+ * @brief Pasa a disco lo anotado y cierra el diario (sus archivos se conservan)
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @return Estado_t E_OK, o E_PAR_INC si el diario no está activo
+ */
+Estado_t desactivarDiarioProcesoPar(ProcesoPar_t *procesoPar);
+
+/**
+ * @brief Empieza a capturar el tráfico de un proceso par en un archivo
+ *
+ * Cada mensaje enviado o recibido (ya descomprimido) se anota con su
+ * instante en un anillo del proceso par, sin cerrojos, y un hilo de volcado
+ * lo escribe en el archivo. Si el volcado no da abasto, los mensajes que no
+ * caben se descartan y se cuentan, en vez de frenar al que envía o recibe.
+ * Un envío se anota solo si se escribió entero, y en el orden de la
+ * tubería: mientras dura la captura, también los envíos sin tramas toman
+ * el cerrojo de envío. El archivo se reproduce con herramientas/reproductor.
+ * Solo Linux.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param rutaArchivo Archivo de captura a crear (se trunca si existe)
+ * @param bytesAnillo Tamaño del anillo (0: PROCESOPAR_CAPTURA_BYTES)
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t iniciarCapturaProcesoPar(ProcesoPar_t *procesoPar, const char *rutaArchivo, size_t bytesAnillo);
+
+/**
+ * @brief Termina la captura, volcando lo pendiente y cerrando el archivo
+ *
+ * destruirProcesoPar() la termina automáticamente.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param descartados Si no es NULL, recibe los mensajes que no cupieron en el anillo
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t detenerCapturaProcesoPar(ProcesoPar_t *procesoPar, unsigned long long *descartados);
+
+/**
+ * @brief Arranca el hilo muestreador de recursos (o cambia su intervalo)
+ *
+ * Un único hilo recorre todos los procesos pares registrados. Los archivos
+ * de /proc se mantienen abiertos y se releen con pread sobre un buffer
+ * reutilizado, así que cada muestra cuesta cuatro lecturas por hijo. Solo Linux.
+ *
+ * @param msIntervalo Periodo de muestreo en milisegundos
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t iniciarMuestreoRecursos(int msIntervalo);
+
+/**
+ * @brief Detiene el hilo muestreador (los registros se conservan)
+ *
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t detenerMuestreoRecursos(void);
+
+/**
+ * @brief Registra un proceso par en el muestreador de recursos
+ *
+ * Abre sus archivos de /proc y reserva un anillo de `capacidad` muestras
+ * (0 para PROCESOPAR_MUESTRAS_DEFECTO). destruirProcesoPar() lo elimina
+ * del muestreador automáticamente.
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param capacidad Muestras que se conservan (las más antiguas se sobrescriben)
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t registrarMuestreoProcesoPar(ProcesoPar_t *procesoPar, int capacidad);
+
+/**
+ * @brief Copia las muestras más recientes de un proceso par
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param muestras Destino, de la más antigua a la más reciente
+ * @param maximo Número de elementos de muestras
+ * @param numero Recibe cuántas muestras se copiaron
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t obtenerMuestrasRecursos(
+    ProcesoPar_t *procesoPar,
+    MuestraRecursos_t *muestras,
+    int maximo,
+    int *numero
+);
+
+/**
+ * @brief Establece un umbral de recurso con su función de aviso
+ *
+ * @param procesoPar Proceso par registrado en el muestreador
+ * @param recurso PROCESOPAR_RECURSO_RSS, _CPU o _ES
+ * @param limite Valor a partir del cual se avisa
+ * @param f Función de aviso (NULL para quitar el umbral)
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t establecerUmbralRecursos(
+    ProcesoPar_t *procesoPar,
+    int recurso,
+    unsigned long long limite,
+    FuncionUmbral_t f
+);
+
+/**
+ * @brief Obtiene los contadores de compresión de un proceso par
+ *
+ * @param procesoPar Puntero a la estructura del proceso par
+ * @param estadisticas Estructura donde se copian los contadores
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t obtenerEstadisticasCompresion(
+    ProcesoPar_t *procesoPar,
+    EstadisticasCompresion_t *estadisticas
+);
+
+/**
+ * @brief Busca en bloque las posiciones de un delimitador
+ *
+ * Recorre `datos` con instrucciones vectoriales (AVX2 o SSE2, elegidas al
+ * arrancar según la CPU; recorrido con memchr en otras arquitecturas) y
+ * anota hasta `maximo` posiciones de una sola pasada. Es lo que usan los
+ * procesos pares lanzados con `delimitador` para separar los mensajes.
+ *
+ * @param datos Bytes a recorrer
+ * @param longitud Bytes de datos (hasta 4 GiB)
+ * @param delimitador Byte buscado (0-255)
+ * @param posiciones Recibe las posiciones encontradas, en orden
+ * @param maximo Número de elementos de posiciones
+ * @param numero Recibe cuántas posiciones se encontraron
+ * @param revisados Si no es NULL, recibe cuántos bytes se recorrieron: longitud,
+ *                  o lo que sigue a la última posición si se llenó `posiciones`
+ * @return Estado_t E_OK si tiene éxito, código de error en caso contrario
+ */
+Estado_t buscarDelimitadores(
+    const char *datos,
+    size_t longitud,
+    int delimitador,
+    uint32_t *posiciones,
+    int maximo,
+    int *numero,
+    size_t *revisados
+);
+
+/**
+ * @brief Comprime un bloque con el códec PPLZ (formato de bloque tipo LZ4)
+ *
+ * @param origen Datos a comprimir
+ * @param longitud Bytes de origen
+ * @param destino Buffer de salida
+ * @param capacidad Tamaño de destino (PPLZ_CAPACIDAD_MAXIMA(longitud) siempre basta)
+ * @param longitudComprimida Bytes escritos en destino
+ * @return Estado_t E_OK, o E_NO_MEMORIA si el resultado no cabe en destino
+ */
+Estado_t comprimirPPLZ(
+    const char *origen,
+    int longitud,
+    char *destino,
+    int capacidad,
+    int *longitudComprimida
+);
+
+/**
+ * @brief Descomprime un bloque PPLZ
+ *
+ * @param origen Bloque comprimido
+ * @param longitud Bytes del bloque
+ * @param destino Buffer de salida
+ * @param capacidad Tamaño de destino
+ * @param longitudOriginal Bytes escritos en destino
+ * @return Estado_t E_OK, o E_DATOS_CORRUPTOS si el bloque no es válido o no cabe
+ */
+Estado_t descomprimirPPLZ(
+    const char *origen,
+    int longitud,
+    char *destino,
+    int capacidad,
+    int *longitudOriginal
+);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* PROCESOPAR_H */
@@ -0,0 +1,631 @@
+/**
+ * @file ProcesoParCorrutinas.hpp
+ * @brief Corrutinas C++20 sobre ProcesoPar: enviar, recibir y llamar con co_await
+ *
+ * Capa de solo encabezado (solo Linux). Un Bucle vigila con epoll los
+ * descriptores de lectura de muchos procesos pares en modo de sondeo y
+ * reanuda en su propio hilo las corrutinas que esperan mensajes; no hay
+ * hilo de escucha ni cerrojos:
+ *
+ * @code
+ * Tarea<> conversacion(Par &par, int n) {
+ *     char respuesta[256];
+ *     for (int i = 0; i < n; i++) {
+ *         Recepcion r = co_await par.llamar("PING\n", 5, respuesta, sizeof(respuesta));
+ *         if (r.estado != E_OK) {
+ *             co_return;
+ *         }
+ *     }
+ * }
+ *
+ * Bucle bucle;
+ * Par par(bucle, pp);               // pp lanzado con delimitador '\n' o compresión
+ * for (int i = 0; i < 1000; i++) {
+ *     bucle.lanzar(conversacion(par, 100));
+ * }
+ * bucle.ejecutar();                 // vuelve cuando terminan todas
+ * @endcode
+ *
+ * Cada mensaje recibido se copia directamente en el buffer de la corrutina
+ * que lo espera, sin memoria dinámica por mensaje. Las corrutinas cuyo
+ * primer parámetro es `Par &` reservan su marco en el pool de ese par, que
+ * reutiliza los marcos liberados por tamaños.
+ *
+ * Los mensajes del hijo se reparten por orden entre las esperas de
+ * recibir() y llamar() en el orden en que empezaron a esperar, igual que
+ * llamarProcesoPar() supone que el hijo responde en orden. enviar() escribe
+ * en el acto (la biblioteca no tiene envío no bloqueante): con mensajes
+ * pequeños y un hijo que lee, la tubería no llega a llenarse.
+ *
+ * Todo (corrutinas, Par y Bucle) se usa desde el hilo que llama a
+ * Bucle::ejecutar(). Requiere -std=c++20. GCC 12 sin optimizar avisa en
+ * falso con -Wmismatched-new-delete sobre los marcos reservados en el pool.
+ */
+
+#ifndef PROCESOPAR_CORRUTINAS_HPP
+#define PROCESOPAR_CORRUTINAS_HPP
+
+#if !defined(__linux__)
+    #error "ProcesoParCorrutinas.hpp solo está disponible en Linux (epoll)"
+#endif
+
+#include "ProcesoPar.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace procesopar {
+
+/* ============================================================================
+ * POOL DE MARCOS
+ * ============================================================================ */
+
+/**
+ * @brief Reutiliza los marcos de corrutina de un par por clases de tamaño
+ *
+ * Los marcos de una misma función tienen siempre el mismo tamaño, así que
+ * tras las primeras conversaciones no se vuelve a pedir memoria.
+ */
+class PoolMarcos {
+public:
+    static constexpr size_t GRANO = 64;     /* Clases de 64 en 64 bytes */
+    static constexpr size_t CLASES = 64;    /* Hasta 4 KB; los mayores van al operador global */
+
+    PoolMarcos() = default;
+    PoolMarcos(const PoolMarcos &) = delete;
+    PoolMarcos &operator=(const PoolMarcos &) = delete;
+
+    ~PoolMarcos() {
+        for (size_t c = 0; c < CLASES; c++) {
+            while (libres_[c] != nullptr) {
+                Libre *bloque = libres_[c];
+                libres_[c] = bloque->siguiente;
+                ::operator delete(bloque);
+            }
+        }
+    }
+
+    /* Bloque de al menos n bytes, o nullptr si n no tiene clase */
+    void *reservar(size_t n) {
+        if (n == 0 || n > GRANO * CLASES) {
+            return nullptr;
+        }
+        size_t c = (n - 1) / GRANO;
+        if (libres_[c] != nullptr) {
+            Libre *bloque = libres_[c];
+            libres_[c] = bloque->siguiente;
+            reutilizados_++;
+            return bloque;
+        }
+        creados_++;
+        return ::operator new((c + 1) * GRANO);
+    }
+
+    void liberar(void *p, size_t n) {
+        size_t c = (n - 1) / GRANO;
+        Libre *bloque = static_cast<Libre*>(p);
+        bloque->siguiente = libres_[c];
+        libres_[c] = bloque;
+    }
+
+    /* Bloques pedidos al sistema y reservas atendidas sin pedir memoria */
+    uint64_t creados() const { return creados_; }
+    uint64_t reutilizados() const { return reutilizados_; }
+
+private:
+    struct Libre {
+        Libre *siguiente;
+    };
+    Libre *libres_[CLASES] = {};
+    uint64_t creados_ = 0;
+    uint64_t reutilizados_ = 0;
+};
+
+namespace detalle {
+
+/* Precede a cada marco: a qué pool devolverlo (nullptr: operador global) */
+struct alignas(std::max_align_t) CabeceraMarco {
+    PoolMarcos *pool;
+};
+
+inline void *reservarMarco(PoolMarcos *pool, size_t n) {
+    size_t total = n + sizeof(CabeceraMarco);
+    void *bloque = (pool != nullptr) ? pool->reservar(total) : nullptr;
+    if (bloque == nullptr) {
+        pool = nullptr;
+        bloque = ::operator new(total);
+    }
+    CabeceraMarco *cabecera = static_cast<CabeceraMarco*>(bloque);
+    cabecera->pool = pool;
+    return cabecera + 1;
+}
+
+inline void liberarMarco(void *marco, size_t n) {
+    CabeceraMarco *cabecera = static_cast<CabeceraMarco*>(marco) - 1;
+    if (cabecera->pool != nullptr) {
+        cabecera->pool->liberar(cabecera, n + sizeof(CabeceraMarco));
+    } else {
+        ::operator delete(cabecera);
+    }
+}
+
+} /* namespace detalle */
+
+class Bucle;
+class Par;
+
+/**
+ * @brief Resultado de recibir() y llamar()
+ *
+ * Si el mensaje no cupo, se copiaron `capacidad` bytes y `longitud` indica
+ * el tamaño real (como en recibirMensajesProcesoPar()).
+ */
+struct Recepcion {
+    Estado_t estado;
+    int longitud;
+};
+
+/* ============================================================================
+ * PAR
+ * ============================================================================ */
+
+/**
+ * @brief Proceso par atendido por un Bucle
+ *
+ * Pone el proceso par en modo de sondeo (no debe tener función de escucha
+ * ni llamadas con llamarProcesoPar()). No lo destruye: debe seguir vivo
+ * mientras exista el Par, y el Par mientras alguna corrutina lo use.
+ */
+class Par {
+public:
+    Par(Bucle &bucle, ProcesoPar_t *pp);
+    ~Par();
+
+    Par(const Par &) = delete;
+    Par &operator=(const Par &) = delete;
+
+    /* E_OK, el error de obtenerDescriptorLecturaProcesoPar() (p. ej. E_MODO) o
+     * el estado final con que terminó una recepción (p. ej. hijo terminado) */
+    Estado_t estado() const { return estado_; }
+
+    ProcesoPar_t *procesoPar() const { return pp_; }
+    Bucle &bucle() const { return bucle_; }
+    PoolMarcos &marcos() { return marcos_; }
+
+    /**
+     * @brief Espera del siguiente mensaje del hijo, copiado en `datos`
+     *
+     * Vive en el marco de la corrutina: encolarla no reserva memoria.
+     */
+    class Espera {
+    public:
+        Espera(Par &par, char *datos, int capacidad)
+            : par_(par), mensaje_{datos, capacidad, 0} {}
+
+        bool await_ready() {
+            if (resultado_.estado != E_OK) {
+                return true;
+            }
+            /* Sin otras esperas delante, lo ya llegado es para esta */
+            return par_.primera_ == nullptr && par_.recibirAhora(*this);
+        }
+
+        void await_suspend(std::coroutine_handle<> h) {
+            corrutina_ = h;
+            par_.encolar(this);
+        }
+
+        Recepcion await_resume() const { return resultado_; }
+
+    protected:
+        friend class Par;
+        Par &par_;
+        MensajeRecibido_t mensaje_;
+        Recepcion resultado_{E_OK, 0};
+        std::coroutine_handle<> corrutina_;
+        Espera *siguiente_ = nullptr;
+    };
+
+    /**
+     * @brief Envío inmediato; el resultado es el de enviarMensajeProcesoPar()
+     */
+    struct Envio {
+        Estado_t estado;
+        bool await_ready() const noexcept { return true; }
+        void await_suspend(std::coroutine_handle<>) const noexcept {}
+        Estado_t await_resume() const noexcept { return estado; }
+    };
+
+    /**
+     * @brief Envía la petición y espera el siguiente mensaje como respuesta
+     *
+     * La espera ocupa su puesto en la cola al enviar, antes de que otra
+     * corrutina pueda enviar nada.
+     */
+    class Llamada : public Espera {
+    public:
+        Llamada(Par &par, const char *peticion, int longitud, char *datos, int capacidad)
+            : Espera(par, datos, capacidad) {
+            resultado_.estado = (par.estado_ != E_OK)
+                ? par.estado_
+                : enviarMensajeProcesoPar(par.pp_, peticion, longitud);
+        }
+    };
+
+    Envio enviar(const char *mensaje, int longitud) {
+        return Envio{estado_ != E_OK ? estado_ : enviarMensajeProcesoPar(pp_, mensaje, longitud)};
+    }
+
+    Espera recibir(char *datos, int capacidad) {
+        Espera espera(*this, datos, capacidad);
+        espera.resultado_.estado = estado_;
+        return espera;
+    }
+
+    Llamada llamar(const char *peticion, int longitud, char *datos, int capacidad) {
+        return Llamada(*this, peticion, longitud, datos, capacidad);
+    }
+
+private:
+    friend class Bucle;
+
+    /* Intenta completar una espera sin bloquear; true si ya tiene resultado */
+    bool recibirAhora(Espera &espera) {
+        int recibidos = 0;
+        Estado_t e = recibirMensajesProcesoPar(pp_, &espera.mensaje_, 1, &recibidos);
+        if (e != E_OK || recibidos == 1) {
+            espera.resultado_ = Recepcion{e, espera.mensaje_.longitud};
+            return true;
+        }
+        return false;
+    }
+
+    void encolar(Espera *espera) {
+        if (ultima_ != nullptr) {
+            ultima_->siguiente_ = espera;
+            ultima_ = espera;
+        } else {
+            primera_ = ultima_ = espera;
+            vigilar(true);
+        }
+    }
+
+    /* Entrega lo disponible a las esperas en orden (el Bucle la llama al haber datos) */
+    void atender();
+
+    /* El descriptor solo está en epoll con esperas en cola; si no, lo leído aguarda en la tubería */
+    void vigilar(bool activar);
+
+    /* Estado final: falla las esperas en cola y las que se creen después */
+    void terminar(Estado_t estado);
+
+    Bucle &bucle_;
+    ProcesoPar_t *pp_;
+    int fd_ = -1;
+    Estado_t estado_;
+    bool vigilado_ = false;
+    Espera *primera_ = nullptr;
+    Espera *ultima_ = nullptr;
+    PoolMarcos marcos_;
+};
+
+/* ============================================================================
+ * TAREA
+ * ============================================================================ */
+
+template <class T = void>
+class Tarea;
+
+namespace detalle {
+
+struct PromesaBase {
+    std::coroutine_handle<> continuacion;   /* Quien hizo co_await de la tarea */
+    Bucle *bucle = nullptr;                 /* Bucle que la lanzó sin esperarla */
+
+    /* Corrutinas cuyo primer parámetro es Par &: marco en el pool del par */
+    template <class... Resto>
+    static void *operator new(size_t n, Par &par, Resto &...) {
+        return reservarMarco(&par.marcos(), n);
+    }
+    static void *operator new(size_t n) {
+        return reservarMarco(nullptr, n);
+    }
+    static void operator delete(void *marco, size_t n) {
+        liberarMarco(marco, n);
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { std::terminate(); }
+};
+
+/* Al terminar: volver a quien esperaba, o liberar la tarea lanzada */
+template <class Promesa>
+struct FinTarea {
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promesa> h) noexcept;
+    void await_resume() const noexcept {}
+};
+
+template <class T>
+struct Promesa : PromesaBase {
+    T valor{};
+    Tarea<T> get_return_object() noexcept;
+    FinTarea<Promesa> final_suspend() noexcept { return {}; }
+    void return_value(T v) { valor = std::move(v); }
+};
+
+template <>
+struct Promesa<void> : PromesaBase {
+    Tarea<void> get_return_object() noexcept;
+    FinTarea<Promesa> final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+};
+
+} /* namespace detalle */
+
+/**
+ * @brief Corrutina perezosa: empieza al hacer co_await de ella o al lanzarla en un Bucle
+ */
+template <class T>
+class Tarea {
+public:
+    using promise_type = detalle::Promesa<T>;
+
+    Tarea(Tarea &&otra) noexcept : h_(std::exchange(otra.h_, {})) {}
+    Tarea &operator=(Tarea &&otra) noexcept {
+        if (this != &otra) {
+            if (h_) {
+                h_.destroy();
+            }
+            h_ = std::exchange(otra.h_, {});
+        }
+        return *this;
+    }
+    ~Tarea() {
+        if (h_) {
+            h_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> quien) noexcept {
+        h_.promise().continuacion = quien;
+        return h_;
+    }
+    T await_resume() {
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(h_.promise().valor);
+        }
+    }
+
+private:
+    friend class Bucle;
+    friend promise_type;
+    explicit Tarea(std::coroutine_handle<promise_type> h) : h_(h) {}
+    std::coroutine_handle<promise_type> h_;
+};
+
+namespace detalle {
+
+template <class T>
+Tarea<T> Promesa<T>::get_return_object() noexcept {
+    return Tarea<T>(std::coroutine_handle<Promesa>::from_promise(*this));
+}
+
+inline Tarea<void> Promesa<void>::get_return_object() noexcept {
+    return Tarea<void>(std::coroutine_handle<Promesa>::from_promise(*this));
+}
+
+} /* namespace detalle */
+
+/* ============================================================================
+ * BUCLE
+ * ============================================================================ */
+
+/**
+ * @brief Ejecutor de un hilo: cola de corrutinas listas más epoll sobre los pares
+ */
+class Bucle {
+public:
+    /* Eventos de epoll que se recogen en cada vuelta */
+    static constexpr int EVENTOS = 64;
+
+    Bucle() : epoll_(epoll_create1(EPOLL_CLOEXEC)) {}
+    ~Bucle() {
+        while (libresNodos_ != nullptr) {
+            Nodo *nodo = libresNodos_;
+            libresNodos_ = nodo->siguiente;
+            delete nodo;
+        }
+        if (epoll_ != -1) {
+            close(epoll_);
+        }
+    }
+
+    Bucle(const Bucle &) = delete;
+    Bucle &operator=(const Bucle &) = delete;
+
+    /* Pone en marcha una tarea sin esperarla; su marco se libera al terminar */
+    void lanzar(Tarea<void> tarea) {
+        auto h = std::exchange(tarea.h_, {});
+        h.promise().bucle = this;
+        vivas_++;
+        programar(h);
+    }
+
+    /* Reanuda h en la próxima vuelta del bucle */
+    void programar(std::coroutine_handle<> h) {
+        Nodo *nodo = libresNodos_;
+        if (nodo != nullptr) {
+            libresNodos_ = nodo->siguiente;
+        } else {
+            nodo = new Nodo;
+        }
+        nodo->h = h;
+        nodo->siguiente = nullptr;
+        if (ultimoListo_ != nullptr) {
+            ultimoListo_->siguiente = nodo;
+        } else {
+            primerListo_ = nodo;
+        }
+        ultimoListo_ = nodo;
+    }
+
+    /**
+     * @brief Atiende corrutinas y pares hasta que terminen todas las tareas lanzadas
+     */
+    void ejecutar() {
+        epoll_event eventos[EVENTOS];
+
+        while (vivas_ > 0) {
+            /* Reanudar las listas; las que programen otras se atienden en la misma vuelta */
+            while (primerListo_ != nullptr) {
+                Nodo *nodo = primerListo_;
+                primerListo_ = nodo->siguiente;
+                if (primerListo_ == nullptr) {
+                    ultimoListo_ = nullptr;
+                }
+                std::coroutine_handle<> h = nodo->h;
+                nodo->siguiente = libresNodos_;
+                libresNodos_ = nodo;
+                h.resume();
+            }
+            if (vivas_ == 0) {
+                break;
+            }
+
+            int n = epoll_wait(epoll_, eventos, EVENTOS, -1);
+            for (int i = 0; i < n; i++) {
+                static_cast<Par*>(eventos[i].data.ptr)->atender();
+            }
+        }
+    }
+
+private:
+    friend class Par;
+    template <class Promesa>
+    friend struct detalle::FinTarea;
+
+    struct Nodo {
+        std::coroutine_handle<> h;
+        Nodo *siguiente;
+    };
+
+    void terminada() { vivas_--; }
+
+    int epoll_;
+    size_t vivas_ = 0;
+    Nodo *primerListo_ = nullptr;
+    Nodo *ultimoListo_ = nullptr;
+    Nodo *libresNodos_ = nullptr;   /* Nodos reutilizados: sin memoria por reanudación */
+};
+
+/* ============================================================================
+ * IMPLEMENTACIÓN
+ * ============================================================================ */
+
+namespace detalle {
+
+template <class Promesa>
+std::coroutine_handle<> FinTarea<Promesa>::await_suspend(std::coroutine_handle<Promesa> h) noexcept {
+    PromesaBase &p = h.promise();
+    if (p.continuacion) {
+        return p.continuacion;
+    }
+    if (p.bucle != nullptr) {
+        Bucle *bucle = p.bucle;
+        h.destroy();
+        bucle->terminada();
+    }
+    return std::noop_coroutine();
+}
+
+} /* namespace detalle */
+
+inline Par::Par(Bucle &bucle, ProcesoPar_t *pp) : bucle_(bucle), pp_(pp) {
+    estado_ = obtenerDescriptorLecturaProcesoPar(pp, &fd_);
+}
+
+inline Par::~Par() {
+    if (vigilado_) {
+        epoll_ctl(bucle_.epoll_, EPOLL_CTL_DEL, fd_, nullptr);
+    }
+}
+
+inline void Par::vigilar(bool activar) {
+    if (vigilado_ == activar) {
+        return;
+    }
+    /* Quitar el descriptor en vez de dejarlo sin eventos: EPOLLHUP y EPOLLERR
+     * se notifican siempre, y con el hijo muerto el bucle giraría sin parar */
+    if (activar) {
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.ptr = this;
+        if (epoll_ctl(bucle_.epoll_, EPOLL_CTL_ADD, fd_, &evento) == -1) {
+            terminar(E_PAR_INC);
+            return;
+        }
+    } else {
+        epoll_ctl(bucle_.epoll_, EPOLL_CTL_DEL, fd_, nullptr);
+    }
+    vigilado_ = activar;
+}
+
+inline void Par::terminar(Estado_t estado) {
+    estado_ = estado;
+    while (primera_ != nullptr) {
+        Espera *e = primera_;
+        primera_ = e->siguiente_;
+        e->resultado_ = Recepcion{estado, 0};
+        bucle_.programar(e->corrutina_);
+    }
+    ultima_ = nullptr;
+    vigilar(false);
+}
+
+inline void Par::atender() {
+    /* Varias esperas a la vez: una sola lectura de la tubería para todas */
+    MensajeRecibido_t lote[Bucle::EVENTOS];
+
+    while (primera_ != nullptr) {
+        int n = 0;
+        for (Espera *e = primera_; e != nullptr && n < Bucle::EVENTOS; e = e->siguiente_) {
+            lote[n++] = e->mensaje_;
+        }
+
+        int recibidos = 0;
+        Estado_t estado = recibirMensajesProcesoPar(pp_, lote, n, &recibidos);
+
+        for (int i = 0; i < recibidos; i++) {
+            Espera *e = primera_;
+            primera_ = e->siguiente_;
+            e->resultado_ = Recepcion{E_OK, lote[i].longitud};
+            bucle_.programar(e->corrutina_);
+        }
+
+        if (estado != E_OK) {
+            /* Hijo terminado o trama corrupta: ya no llegará nada más */
+            terminar(estado);
+            return;
+        }
+        if (recibidos < n) {
+            break;
+        }
+    }
+
+    if (primera_ == nullptr) {
+        ultima_ = nullptr;
+        vigilar(false);
+    }
+}
+
+} /* namespace procesopar */
+
+#endif /* PROCESOPAR_CORRUTINAS_HPP */
@@ -0,0 +1,443 @@
+/**
+ * @file ProcesoParTipado.hpp
+ * @brief Mensajes tipados sobre ProcesoPar: codificación binaria en tiempo de compilación
+ *
+ * Capa C++17 de solo encabezado. Cada tipo de mensaje se declara una vez
+ * como estructura con un identificador `tipo` y una función `campos()` que
+ * enumera sus miembros:
+ *
+ * @code
+ * struct Ping {
+ *     static constexpr uint16_t tipo = 1;
+ *     uint32_t secuencia;
+ *     int64_t instante;
+ *     static constexpr auto campos() {
+ *         return std::make_tuple(&Ping::secuencia, &Ping::instante);
+ *     }
+ * };
+ * @endcode
+ *
+ * A partir de ahí las plantillas generan el codificador y el decodificador:
+ * disposición fija, little-endian sea cual sea la máquina, tamaño conocido
+ * en compilación y sin memoria dinámica. Cada mensaje viaja como registro
+ * `[u32 longitud][u16 tipo][carga]`, donde longitud cuenta solo la carga.
+ *
+ * Del lado receptor, Despachador<Tipos...> compara el `tipo` de cada
+ * registro con los tipos declarados (tabla generada en compilación) y llama
+ * al manejador tipado, sin comparar cadenas. Acumulador junta los trozos
+ * que entrega la función de escucha hasta tener registros completos.
+ *
+ * Tipos de campo admitidos: enteros, enumeraciones, bool, float, double,
+ * arrays de tamaño fijo (T[N] y std::array) y otras estructuras con campos().
+ */
+
+#ifndef PROCESOPAR_TIPADO_HPP
+#define PROCESOPAR_TIPADO_HPP
+
+#include "ProcesoPar.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace procesopar {
+
+/* Bytes de la cabecera de registro: longitud (u32) + tipo (u16) */
+constexpr size_t TAMANO_CABECERA = 6;
+
+namespace detalle {
+
+template <class T, class = void>
+struct TieneCampos : std::false_type {};
+
+template <class T>
+struct TieneCampos<T, std::void_t<decltype(T::campos())>> : std::true_type {};
+
+template <class T>
+struct EsStdArray : std::false_type {};
+
+template <class T, size_t N>
+struct EsStdArray<std::array<T, N>> : std::true_type {};
+
+/* Tipo de un miembro a partir de su puntero a miembro */
+template <class P>
+struct TipoMiembro;
+
+template <class C, class M>
+struct TipoMiembro<M C::*> {
+    using Tipo = M;
+};
+
+/* ------------------------------------------------------------------------
+ * Tamaño codificado
+ * ------------------------------------------------------------------------ */
+
+template <class T>
+constexpr size_t tamano();
+
+template <class Tupla, size_t... I>
+constexpr size_t sumarCampos(std::index_sequence<I...>) {
+    return (size_t{0} + ... +
+            tamano<typename TipoMiembro<std::tuple_element_t<I, Tupla>>::Tipo>());
+}
+
+template <class T>
+constexpr size_t tamano() {
+    if constexpr (std::is_same_v<T, bool>) {
+        return 1;
+    } else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+        return sizeof(T);
+    } else if constexpr (std::is_enum_v<T>) {
+        return sizeof(std::underlying_type_t<T>);
+    } else if constexpr (std::is_array_v<T>) {
+        return std::extent_v<T> * tamano<std::remove_extent_t<T>>();
+    } else if constexpr (EsStdArray<T>::value) {
+        return std::tuple_size_v<T> * tamano<typename T::value_type>();
+    } else {
+        static_assert(TieneCampos<T>::value, "Tipo de campo no admitido: declare campos()");
+        using Tupla = decltype(T::campos());
+        return sumarCampos<Tupla>(std::make_index_sequence<std::tuple_size_v<Tupla>>{});
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * Enteros little-endian
+ * ------------------------------------------------------------------------ */
+
+template <class U>
+inline void escribirLE(uint8_t *p, U valor) {
+    for (size_t i = 0; i < sizeof(U); i++) {
+        p[i] = static_cast<uint8_t>(valor >> (8 * i));
+    }
+}
+
+template <class U>
+inline U leerLE(const uint8_t *p) {
+    U valor = 0;
+    for (size_t i = 0; i < sizeof(U); i++) {
+        valor = static_cast<U>(valor | (static_cast<U>(p[i]) << (8 * i)));
+    }
+    return valor;
+}
+
+template <size_t N>
+struct EnteroDeTamano;
+template <> struct EnteroDeTamano<1> { using Tipo = uint8_t; };
+template <> struct EnteroDeTamano<2> { using Tipo = uint16_t; };
+template <> struct EnteroDeTamano<4> { using Tipo = uint32_t; };
+template <> struct EnteroDeTamano<8> { using Tipo = uint64_t; };
+
+/* ------------------------------------------------------------------------
+ * Codificación y decodificación campo a campo
+ * ------------------------------------------------------------------------ */
+
+template <class T>
+inline uint8_t *codificarValor(uint8_t *p, const T &valor);
+
+template <class T>
+inline const uint8_t *decodificarValor(const uint8_t *p, T &valor);
+
+template <class T>
+inline uint8_t *codificarValor(uint8_t *p, const T &valor) {
+    if constexpr (std::is_same_v<T, bool>) {
+        *p = valor ? 1 : 0;
+        return p + 1;
+    } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T> || std::is_floating_point_v<T>) {
+        using U = typename EnteroDeTamano<sizeof(T)>::Tipo;
+        U bits;
+        std::memcpy(&bits, &valor, sizeof(T));
+        escribirLE(p, bits);
+        return p + sizeof(T);
+    } else if constexpr (std::is_array_v<T> || EsStdArray<T>::value) {
+        for (const auto &elemento : valor) {
+            p = codificarValor(p, elemento);
+        }
+        return p;
+    } else {
+        std::apply([&](auto... miembros) { ((p = codificarValor(p, valor.*miembros)), ...); },
+                   T::campos());
+        return p;
+    }
+}
+
+template <class T>
+inline const uint8_t *decodificarValor(const uint8_t *p, T &valor) {
+    if constexpr (std::is_same_v<T, bool>) {
+        valor = (*p != 0);
+        return p + 1;
+    } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T> || std::is_floating_point_v<T>) {
+        using U = typename EnteroDeTamano<sizeof(T)>::Tipo;
+        U bits = leerLE<U>(p);
+        std::memcpy(&valor, &bits, sizeof(T));
+        return p + sizeof(T);
+    } else if constexpr (std::is_array_v<T> || EsStdArray<T>::value) {
+        for (auto &elemento : valor) {
+            p = decodificarValor(p, elemento);
+        }
+        return p;
+    } else {
+        std::apply([&](auto... miembros) { ((p = decodificarValor(p, valor.*miembros)), ...); },
+                   T::campos());
+        return p;
+    }
+}
+
+/* Identificadores distintos entre los tipos de un despachador */
+template <class... Tipos>
+constexpr bool tiposUnicos() {
+    constexpr uint16_t ids[] = {Tipos::tipo...};
+    for (size_t i = 0; i < sizeof...(Tipos); i++) {
+        for (size_t j = i + 1; j < sizeof...(Tipos); j++) {
+            if (ids[i] == ids[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace detalle
+
+/**
+ * @brief Bytes de la carga útil de un mensaje (conocido en compilación)
+ */
+template <class T>
+constexpr size_t tamanoCarga() {
+    return detalle::tamano<T>();
+}
+
+/**
+ * @brief Bytes del registro completo (cabecera + carga)
+ */
+template <class T>
+constexpr size_t tamanoRegistro() {
+    return TAMANO_CABECERA + tamanoCarga<T>();
+}
+
+/**
+ * @brief Codifica un mensaje como registro en `destino`
+ *
+ * @param destino Al menos tamanoRegistro<T>() bytes
+ * @return Bytes escritos (siempre tamanoRegistro<T>())
+ */
+template <class T>
+inline size_t codificar(const T &mensaje, uint8_t *destino) {
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(T::tipo)>, uint16_t>,
+                  "El mensaje debe declarar static constexpr uint16_t tipo");
+    detalle::escribirLE(destino, static_cast<uint32_t>(tamanoCarga<T>()));
+    detalle::escribirLE(destino + 4, T::tipo);
+    detalle::codificarValor(destino + TAMANO_CABECERA, mensaje);
+    return tamanoRegistro<T>();
+}
+
+/**
+ * @brief Decodifica la carga útil de un mensaje
+ *
+ * @return false si la longitud no coincide con la disposición de T
+ */
+template <class T>
+inline bool decodificar(const uint8_t *carga, size_t longitud, T &mensaje) {
+    if (longitud != tamanoCarga<T>()) {
+        return false;
+    }
+    detalle::decodificarValor(carga, mensaje);
+    return true;
+}
+
+/**
+ * @brief Codifica un mensaje en la pila y lo envía al proceso par
+ */
+template <class T>
+inline Estado_t enviar(ProcesoPar_t *procesoPar, const T &mensaje) {
+    std::array<uint8_t, tamanoRegistro<T>()> registro;
+    codificar(mensaje, registro.data());
+    return enviarMensajeProcesoPar(procesoPar, reinterpret_cast<const char *>(registro.data()),
+                                   static_cast<int>(registro.size()));
+}
+
+/**
+ * @brief Agrupa varias lambdas en un único visitante sobrecargado
+ *
+ * @code
+ * Sobrecarga visitante{
+ *     [](const Ping &p) { ... },
+ *     [](const Pong &p) { ... },
+ * };
+ * @endcode
+ */
+template <class... F>
+struct Sobrecarga : F... {
+    using F::operator()...;
+};
+template <class... F>
+Sobrecarga(F...) -> Sobrecarga<F...>;
+
+/* Resultado de Despachador::despachar() */
+enum class Despacho {
+    Entregado,      /* Se llamó al manejador del tipo */
+    Desconocido,    /* Ningún tipo declarado tiene ese identificador */
+    Invalido        /* La longitud no corresponde al tipo */
+};
+
+/**
+ * @brief Despacha registros a manejadores tipados según su identificador
+ *
+ * La comparación de identificadores se genera en compilación (el
+ * compilador la convierte en un salto por tabla o en comparaciones
+ * encadenadas) y los identificadores repetidos son un error de compilación.
+ */
+template <class... Tipos>
+class Despachador {
+    static_assert(sizeof...(Tipos) > 0, "Declare al menos un tipo de mensaje");
+    static_assert(detalle::tiposUnicos<Tipos...>(), "Identificadores de tipo repetidos");
+
+    template <class T, class Visitante>
+    static bool probar(uint16_t tipo, const uint8_t *carga, size_t longitud,
+                       Visitante &visitante, Despacho &resultado) {
+        if (tipo != T::tipo) {
+            return false;
+        }
+        T mensaje;
+        if (!decodificar(carga, longitud, mensaje)) {
+            resultado = Despacho::Invalido;
+            return true;
+        }
+        visitante(static_cast<const T &>(mensaje));
+        resultado = Despacho::Entregado;
+        return true;
+    }
+
+public:
+    /**
+     * @brief Decodifica una carga útil de identificador `tipo` y llama al visitante
+     */
+    template <class Visitante>
+    static Despacho despachar(uint16_t tipo, const uint8_t *carga, size_t longitud,
+                              Visitante &&visitante) {
+        Despacho resultado = Despacho::Desconocido;
+        (probar<Tipos>(tipo, carga, longitud, visitante, resultado) || ...);
+        return resultado;
+    }
+
+    /**
+     * @brief Tamaño del mayor registro declarado (útil para dimensionar el Acumulador)
+     */
+    static constexpr size_t registroMaximo() {
+        size_t maximo = 0;
+        ((maximo = tamanoRegistro<Tipos>() > maximo ? tamanoRegistro<Tipos>() : maximo), ...);
+        return maximo;
+    }
+};
+
+/**
+ * @brief Junta los trozos recibidos hasta formar registros completos
+ *
+ * Sin tramas, la función de escucha entrega lo que devolvió cada read(),
+ * que puede cortar un registro por la mitad. El acumulador guarda el resto
+ * en un buffer fijo de `Capacidad` bytes y despacha todos los registros
+ * completos de cada trozo.
+ */
+template <size_t Capacidad>
+class Acumulador {
+    uint8_t buffer[Capacidad];
+    size_t usados = 0;
+
+    /* Despacha los registros completos de [datos, datos + n); devuelve los bytes consumidos */
+    template <class D, class Visitante>
+    static size_t procesar(const uint8_t *datos, size_t n, Visitante &visitante, int &entregados,
+                           bool &error) {
+        size_t consumidos = 0;
+        while (n - consumidos >= TAMANO_CABECERA) {
+            const uint8_t *registro = datos + consumidos;
+            uint32_t longitud = detalle::leerLE<uint32_t>(registro);
+            if (longitud > Capacidad - TAMANO_CABECERA) {
+                error = true;
+                return consumidos;
+            }
+            if (n - consumidos < TAMANO_CABECERA + longitud) {
+                break;
+            }
+            uint16_t tipo = detalle::leerLE<uint16_t>(registro + 4);
+            if (D::despachar(tipo, registro + TAMANO_CABECERA, longitud, visitante) ==
+                Despacho::Entregado) {
+                entregados++;
+            }
+            consumidos += TAMANO_CABECERA + longitud;
+        }
+        return consumidos;
+    }
+
+public:
+    /**
+     * @brief Añade un trozo y despacha los registros que queden completos
+     *
+     * @tparam D Despachador<...> con los tipos esperados
+     * @return Registros entregados, o -1 si llega un registro mayor que Capacidad
+     *         (el flujo ya no es recuperable)
+     */
+    template <class D, class Visitante>
+    int agregar(const char *trozo, size_t longitud, Visitante &&visitante) {
+        const uint8_t *datos = reinterpret_cast<const uint8_t *>(trozo);
+        int entregados = 0;
+        bool error = false;
+
+        /* Completar primero el registro partido de la vez anterior */
+        if (usados > 0) {
+            size_t copiar;
+            if (usados < TAMANO_CABECERA) {
+                copiar = TAMANO_CABECERA - usados;
+                copiar = copiar < longitud ? copiar : longitud;
+                std::memcpy(buffer + usados, datos, copiar);
+                usados += copiar;
+                datos += copiar;
+                longitud -= copiar;
+                if (usados < TAMANO_CABECERA) {
+                    return 0;
+                }
+            }
+
+            size_t total = TAMANO_CABECERA + detalle::leerLE<uint32_t>(buffer);
+            if (total > Capacidad) {
+                return -1;
+            }
+            copiar = total - usados;
+            copiar = copiar < longitud ? copiar : longitud;
+            std::memcpy(buffer + usados, datos, copiar);
+            usados += copiar;
+            datos += copiar;
+            longitud -= copiar;
+            if (usados < total) {
+                return 0;
+            }
+
+            procesar<D>(buffer, usados, visitante, entregados, error);
+            usados = 0;
+        }
+
+        /* Registros completos directamente desde el trozo, sin copiarlos */
+        size_t consumidos = procesar<D>(datos, longitud, visitante, entregados, error);
+        if (error) {
+            return -1;
+        }
+
+        /* Guardar el resto para la próxima vez */
+        usados = longitud - consumidos;
+        std::memcpy(buffer, datos + consumidos, usados);
+        return entregados;
+    }
+
+    /**
+     * @brief Descarta lo acumulado
+     */
+    void vaciar() {
+        usados = 0;
+    }
+};
+
+} // namespace procesopar
+
+#endif /* PROCESOPAR_TIPADO_HPP */
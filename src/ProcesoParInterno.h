@@ -0,0 +1,810 @@
+/**
+ * @file ProcesoParInterno.h
+ * @brief Declaraciones internas compartidas por los archivos de la biblioteca
+ *
+ * Este encabezado no forma parte de la API pública: solo lo incluyen los
+ * archivos de src/.
+ */
+
+#ifndef PROCESOPAR_INTERNO_H
+#define PROCESOPAR_INTERNO_H
+
+#include "../include/ProcesoPar.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+    #include <signal.h>
+#endif
+
+/* Función del hilo de escucha (establecerFuncionDeEscucha.c) */
+#ifdef _WIN32
+DWORD WINAPI hiloEscucha(LPVOID param);
+#else
+void* hiloEscucha(void* param);
+#endif
+
+/**
+ * @brief Lanza el hijo sobre una estructura ya reservada (lanzarProcesoParConOpciones.c)
+ *
+ * @param fdEjecutable Descriptor O_PATH del ejecutable ya resuelto, o -1
+ */
+Estado_t iniciarProcesoPar(
+    ProcesoPar_t *pp,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    int fdEjecutable
+);
+
+#ifndef _WIN32
+/**
+ * @brief Copia de lo necesario para relanzar el hijo (una sola reserva)
+ */
+typedef struct LanzamientoProcesoPar {
+    char *nombreArchivoEjecutable;
+    const char **listaLineaComando;   /* NULL si se lanzó sin argumentos */
+    OpcionesProcesoPar_t opciones;    /* Sus listas y cadenas apuntan dentro de la reserva */
+} LanzamientoProcesoPar_t;
+
+/**
+ * @brief Mata al hijo y lanza otro igual en el mismo proceso par (lanzarProcesoParConOpciones.c)
+ *
+ * Las tuberías nuevas ocupan los descriptores de las anteriores y, si había
+ * hilo de escucha, se crea otro. No puede llamarse desde el hilo de escucha.
+ *
+ * @return E_OK; E_PROCESO_INACT si el proceso par ya no está activo (si falla
+ *         después de matar al hijo, también queda inactivo)
+ */
+Estado_t relanzarProcesoPar(ProcesoPar_t *pp);
+#endif
+
+/**
+ * @brief Cabecera del bloque contiguo de un lote (lanzarLoteProcesoPar.c)
+ *
+ * Las estructuras ProcesoPar_t siguen a la cabecera, alineadas a línea de
+ * caché para que los hilos de escucha de pares vecinos no compartan líneas.
+ */
+typedef struct BloqueProcesoPar {
+    int referencias;    /* Procesos pares aún vivos en el bloque */
+} BloqueProcesoPar_t;
+
+#define PP_LINEA_CACHE 64
+
+/**
+ * @brief Libera la memoria de un proceso par (o su referencia al bloque)
+ */
+void liberarProcesoPar(ProcesoPar_t *pp);
+
+/* ============================================================================
+ * TOPOLOGÍA (topologia.c, solo Linux)
+ * ============================================================================ */
+
+/* Máximo de CPUs y nodos que se consideran */
+#define PP_MAX_CPUS  1024
+#define PP_MAX_NODOS 64
+
+/**
+ * @brief Copia las CPUs de un nodo NUMA
+ *
+ * La topología se lee de sysfs la primera vez y se guarda para el resto
+ * del proceso. Sin información NUMA, el nodo 0 contiene todas las CPUs en
+ * línea.
+ *
+ * @return Número de CPUs escritas en cpus, o -1 si el nodo no existe
+ */
+int leerCpusNodo(int nodo, int *cpus, int maximo);
+
+/**
+ * @brief Número de nodos NUMA (al menos 1)
+ */
+int contarNodosNuma(void);
+
+/* ============================================================================
+ * TRAZAS (trazas.c)
+ *
+ * Con -DPROCESOPAR_TRAZAS (make TRAZAS=1), cada punto PP_TRAZA emite una
+ * sonda USDT (si el sistema tiene <sys/sdt.h>) y anota el evento en el
+ * anillo del hilo actual. Sin la opción, PP_TRAZA no genera código.
+ * ============================================================================ */
+
+/* Eventos registrados; INICIO/FIN se vuelcan como intervalos */
+typedef enum EventoTraza {
+    PP_EVENTO_ENVIO_INICIO,       /* enviarMensajeProcesoPar: antes de escribir */
+    PP_EVENTO_ENVIO_FIN,          /* enviarMensajeProcesoPar: tras escribir */
+    PP_EVENTO_LECTURA,            /* hiloEscucha: read() devolvió datos */
+    PP_EVENTO_DESPACHO,           /* hiloEscucha: mensaje completo extraído */
+    PP_EVENTO_CALLBACK_INICIO,    /* Antes de llamar a funcionEscucha */
+    PP_EVENTO_CALLBACK_FIN,       /* Después de llamar a funcionEscucha */
+    PP_EVENTO_LANZAMIENTO,        /* Hijo creado */
+    PP_EVENTO_DESTRUCCION,        /* destruirProcesoPar */
+    PP_NUM_EVENTOS
+} EventoTraza_t;
+
+#ifdef PROCESOPAR_TRAZAS
+    #if defined(__has_include)
+        #if __has_include(<sys/sdt.h>)
+            #include <sys/sdt.h>
+            #define PP_SONDA(evento, pid, valor) DTRACE_PROBE2(procesopar, evento, pid, valor)
+        #endif
+    #endif
+    #ifndef PP_SONDA
+        #define PP_SONDA(evento, pid, valor) ((void)0)
+    #endif
+
+    /* Eventos guardados por hilo antes de sobrescribir los más antiguos */
+    #define PP_EVENTOS_POR_HILO 16384
+
+    typedef struct EventoRegistrado {
+        unsigned long long ns;      /* Instante (reloj monotónico) */
+        int evento;                 /* EventoTraza_t */
+        long pid;                   /* PID del hijo implicado */
+        long long valor;            /* Bytes u otro dato del evento */
+    } EventoRegistrado_t;
+
+    /* Con más anillos que este, uno de un hilo terminado se reutiliza
+     * aunque no se haya volcado */
+    #define PP_MAX_ANILLOS_TRAZA 64
+
+    typedef struct AnilloTraza {
+        EventoRegistrado_t eventos[PP_EVENTOS_POR_HILO];
+        unsigned long long escritos;        /* Total de eventos anotados (release) */
+        unsigned long long volcados;        /* Valor de escritos en el último volcado */
+        int libre;                          /* 1 si su hilo terminó: se puede reutilizar */
+        long tid;                           /* Hilo propietario */
+        struct AnilloTraza *siguiente;      /* Lista global de anillos */
+    } AnilloTraza_t;
+
+    /* Lista de todos los anillos creados (trazas.c) */
+    extern AnilloTraza_t *listaAnillosTraza;
+
+    /**
+     * @brief Anota un evento en el anillo de trazas del hilo actual (sin cerrojos)
+     */
+    void registrarTraza(EventoTraza_t evento, long pid, long long valor);
+
+    #define PP_TRAZA(evento, pid, valor) do { \
+        PP_SONDA(evento, pid, valor); \
+        registrarTraza(PP_EVENTO_##evento, (long)(pid), (long long)(valor)); \
+    } while (0)
+#else
+    #define PP_TRAZA(evento, pid, valor) ((void)0)
+#endif
+
+/* ============================================================================
+ * MUESTREO DE RECURSOS (muestreoRecursos.c, solo Linux)
+ * ============================================================================ */
+
+#ifndef _WIN32
+#include <pthread.h>
+
+/**
+ * @brief Umbral de un recurso de un proceso par
+ */
+typedef struct UmbralRecurso {
+    unsigned long long limite;   /* Valor a partir del cual se avisa */
+    FuncionUmbral_t funcion;     /* NULL si no hay umbral */
+    int superado;                /* 1 mientras el valor siga por encima */
+} UmbralRecurso_t;
+
+/**
+ * @brief Estado de muestreo de un proceso par
+ */
+typedef struct MuestreoRecursos {
+    ProcesoPar_t *pp;
+    int fdStat, fdStatm, fdIo, fdStatus;      /* Archivos de /proc abiertos */
+    MuestraRecursos_t *muestras;              /* Anillo de muestras */
+    int capacidad;                            /* Elementos del anillo */
+    unsigned long long escritas;              /* Total de muestras tomadas */
+    UmbralRecurso_t umbrales[PROCESOPAR_NUM_RECURSOS];
+    struct MuestreoRecursos *siguiente;       /* Lista del muestreador */
+} MuestreoRecursos_t;
+
+/**
+ * @brief Estado global del muestreador; `mutex` protege todo lo demás
+ */
+typedef struct Muestreador {
+    pthread_mutex_t mutex;
+    pthread_cond_t condicion;         /* Despierta al hilo y a quien espera su parada */
+    int condicionLista;               /* 1 si `condicion` ya usa el reloj monotónico */
+    pthread_t hilo;
+    int activo;                       /* 1 desde el arranque hasta el fin del join */
+    int detener;                      /* Petición de parada (con activo: parando) */
+    int msIntervalo;                  /* Periodo de muestreo */
+    MuestreoRecursos_t *lista;        /* Procesos pares registrados */
+} Muestreador_t;
+
+extern Muestreador_t muestreador;
+
+/**
+ * @brief Hilo muestreador
+ */
+void *hiloMuestreador(void *param);
+
+/**
+ * @brief Quita un proceso par del muestreador y cierra sus archivos
+ */
+void desregistrarMuestreoProcesoPar(ProcesoPar_t *pp);
+#endif
+
+/* ============================================================================
+ * LLAMADAS Y CACHÉ DE RESPUESTAS (llamadasProcesoPar.c, cacheRespuestas.c, solo Linux)
+ *
+ * Todo lo de esta sección se protege con pp->mutexLlamadas.
+ * ============================================================================ */
+
+#ifndef _WIN32
+struct EntradaCache;
+
+/**
+ * @brief Llamada enviada al hijo que espera su respuesta
+ *
+ * La referencian quien llamó, la cola (hasta que llega la respuesta) y cada
+ * llamada idéntica agrupada con ella; la libera quien suelta la última.
+ */
+typedef struct LlamadaPendiente {
+    int referencias;
+    int completada;                     /* 1 cuando respuesta y estado son válidos */
+    Estado_t estado;
+    char *respuesta;                    /* Copia de la respuesta (malloc) */
+    int longitudRespuesta;
+    struct EntradaCache *entrada;       /* Entrada de caché que se rellena al completar, o NULL */
+    struct LlamadaPendiente *siguiente; /* Cola de pp */
+} LlamadaPendiente_t;
+
+/**
+ * @brief Entrada de la caché de respuestas
+ */
+typedef struct EntradaCache {
+    char *clave;                        /* Clave y respuesta en la misma reserva */
+    int longitudClave;
+    char *respuesta;                    /* NULL mientras la llamada está en curso */
+    int longitudRespuesta;
+    unsigned long long hash;
+    unsigned long long nsCaducidad;
+    LlamadaPendiente_t *llamada;        /* Llamada en curso, o NULL si ya hay respuesta */
+    struct EntradaCache *siguienteHash; /* Cadena de la cubeta */
+    struct EntradaCache *anterior;      /* Lista LRU: más reciente primero */
+    struct EntradaCache *siguiente;
+} EntradaCache_t;
+
+/**
+ * @brief Caché de respuestas de un proceso par
+ */
+typedef struct CacheRespuestas {
+    EntradaCache_t **cubetas;
+    size_t numCubetas;                  /* Potencia de dos */
+    EntradaCache_t *masReciente;
+    EntradaCache_t *menosReciente;
+    size_t bytesMaximos;
+    unsigned long long nsVida;
+    EstadisticasCache_t estadisticas;
+} CacheRespuestas_t;
+
+/**
+ * @brief Crea el hilo de escucha aunque no haya función de escucha (establecerFuncionDeEscucha.c)
+ */
+Estado_t crearHiloEscucha(ProcesoPar_t *pp);
+
+/**
+ * @brief Entrega un mensaje a la llamada pendiente más antigua o, si no hay, a la función de escucha
+ */
+void despacharMensaje(ProcesoPar_t *pp, const char *mensaje, int longitud);
+
+/**
+ * @brief Completa una llamada ya sacada de la cola y avisa a quien espera
+ */
+void completarLlamada(ProcesoPar_t *pp, LlamadaPendiente_t *llamada,
+                      const char *respuesta, int longitud, Estado_t estado);
+
+/**
+ * @brief Suelta una referencia a una llamada y la libera si era la última
+ */
+void soltarLlamada(LlamadaPendiente_t *llamada);
+
+/**
+ * @brief Completa con E_PROCESO_INACT todas las llamadas pendientes (toma el mutex)
+ */
+void fallarLlamadasPendientes(ProcesoPar_t *pp);
+
+/**
+ * @brief Calcula el hash de una clave de caché
+ */
+unsigned long long hashClaveCache(const char *clave, int longitud);
+
+/**
+ * @brief Busca una entrada por clave (NULL si no existe)
+ */
+EntradaCache_t *buscarEntradaCache(CacheRespuestas_t *cache, const char *clave,
+                                   int longitud, unsigned long long hash);
+
+/**
+ * @brief Crea una entrada en curso para una llamada (NULL si no hay memoria)
+ */
+EntradaCache_t *insertarEntradaCache(CacheRespuestas_t *cache, const char *clave,
+                                     int longitud, unsigned long long hash,
+                                     LlamadaPendiente_t *llamada);
+
+/**
+ * @brief Guarda la respuesta de una entrada en curso y expulsa lo que sobre
+ * @return 0 si no hubo memoria (la entrada se elimina)
+ */
+int guardarRespuestaCache(CacheRespuestas_t *cache, EntradaCache_t *entrada,
+                          const char *respuesta, int longitud);
+
+/**
+ * @brief Marca una entrada como la más reciente
+ */
+void usarEntradaCache(CacheRespuestas_t *cache, EntradaCache_t *entrada);
+
+/**
+ * @brief Elimina y libera una entrada
+ */
+void quitarEntradaCache(CacheRespuestas_t *cache, EntradaCache_t *entrada);
+
+/**
+ * @brief Elimina todas las entradas con respuesta (las que están en curso se conservan)
+ */
+void vaciarCacheRespuestas(CacheRespuestas_t *cache);
+
+/**
+ * @brief Libera la caché, las llamadas restantes y los objetos de sincronización
+ */
+void liberarLlamadasProcesoPar(ProcesoPar_t *pp);
+#endif
+
+/* ============================================================================
+ * REEMPLAZO Y GRUPOS (reemplazoProcesoPar.c, solo Linux)
+ * ============================================================================ */
+
+#ifndef _WIN32
+/**
+ * @brief Proceso par dentro de un grupo
+ *
+ * Se reserva aparte para que quien lo retira del reparto pueda seguir
+ * esperando a que `usos` llegue a 0.
+ */
+typedef struct MiembroGrupo {
+    ProcesoPar_t *pp;
+    int usos;                         /* Envíos y llamadas en curso (con grupo->mutex) */
+} MiembroGrupo_t;
+
+struct GrupoProcesoPar {
+    pthread_mutex_t mutex;            /* Protege el reparto y los usos */
+    pthread_cond_t condicion;         /* Avisa cuando un miembro deja de usarse */
+    pthread_mutex_t mutexActualizacion; /* Una sola actualización a la vez */
+    MiembroGrupo_t **miembros;        /* Miembros en el reparto */
+    int numero;
+    int capacidad;
+    unsigned int siguiente;           /* Turno del reparto */
+};
+
+/**
+ * @brief Espera y consume el mensaje de listo de un hijo recién lanzado
+ *
+ * Se llama antes de que exista el hilo de escucha; lo que llegue detrás
+ * del mensaje se queda en bufferEntrada para el hilo.
+ */
+Estado_t esperarListoProcesoPar(ProcesoPar_t *pp, const OpcionesReemplazo_t *reemplazo);
+
+/* Tras el plazo de drenaje, espera máxima a que salga el hijo antes del SIGKILL */
+#define PP_MS_GRACIA_DRENAJE 50
+
+/**
+ * @brief Cierra la entrada del hijo y espera hasta `nsLimite` a que termine
+ *        (sus respuestas se siguen entregando); si sigue vivo tras una breve
+ *        gracia, lo mata con SIGKILL. Después lo destruye
+ */
+void drenarProcesoPar(ProcesoPar_t *pp, unsigned long long nsLimite);
+
+/**
+ * @brief Toma el siguiente miembro del reparto y anota un uso (NULL si está vacío)
+ */
+MiembroGrupo_t *tomarMiembroGrupo(GrupoProcesoPar_t *grupo);
+
+/**
+ * @brief Suelta el uso anotado por tomarMiembroGrupo()
+ */
+void soltarMiembroGrupo(GrupoProcesoPar_t *grupo, MiembroGrupo_t *miembro);
+
+/**
+ * @brief Espera hasta `nsLimite` a que nadie use un miembro ya retirado del
+ *        reparto y lo drena; si no deja de usarse a tiempo, termina al hijo
+ *        para que las llamadas en curso fallen antes de destruirlo
+ */
+void retirarMiembroGrupo(GrupoProcesoPar_t *grupo, MiembroGrupo_t *miembro,
+                         unsigned long long nsLimite);
+
+/**
+ * @brief Comprueba unas opciones de reemplazo (NULL es válido)
+ */
+int opcionesReemplazoValidas(const OpcionesReemplazo_t *reemplazo);
+
+/**
+ * @brief Instante en que vence un plazo de OpcionesReemplazo_t (0 ms: `msDefecto`)
+ */
+unsigned long long limiteReemplazo(int ms, int msDefecto);
+#endif
+
+/* ============================================================================
+ * LATIDOS (latidos.c, solo Linux)
+ *
+ * Un único hilo avanza una rueda de temporizadores con un timerfd periódico.
+ * Cada proceso par con latido tiene un nodo en la ranura del tic en que
+ * vence: insertarlo y quitarlo es enlazarlo en una lista doble, y cada tic
+ * solo recorre su ranura. Los plazos de más de una vuelta llevan la cuenta
+ * de las vueltas que les faltan.
+ * ============================================================================ */
+
+#ifndef _WIN32
+#define PP_MS_TIC_LATIDO  10
+#define PP_RANURAS_LATIDO 512     /* Potencia de dos */
+
+/**
+ * @brief Latido de un proceso par
+ *
+ * pp->latido se asigna y se borra con latidor.mutex y pp->mutexLlamadas
+ * tomados, así que basta cualquiera de los dos para leerlo.
+ */
+typedef struct LatidoProcesoPar {
+    ProcesoPar_t *pp;
+    char *sonda;                      /* Sonda y respuesta van tras la estructura */
+    int longitudSonda;
+    char *respuesta;
+    int longitudRespuesta;
+    unsigned int tics;                /* Intervalo en tics de la rueda */
+    int fallosMaximos;
+    FuncionLatido_t funcion;
+    int relanzar;
+
+    /* Los escribe el hilo de escucha (atómicos) */
+    unsigned long long recibidos;     /* Mensajes recibidos del hijo */
+    unsigned long long nsRespuesta;   /* Lo que tardó la última respuesta a una sonda */
+    unsigned long long nsSonda;       /* Envío de la sonda sin responder, o 0 */
+
+    /* Con latidor.mutex */
+    unsigned long long recibidosVistos; /* recibidos en el último vencimiento */
+    unsigned long long nsActividad;   /* Último vencimiento en que había mensajes nuevos */
+    unsigned long long sondas;
+    unsigned long long relanzamientos;
+    int fallos;
+    int atascado;
+    int relanzando;                   /* 1 mientras un hilo relanza el hijo */
+
+    /* Rueda */
+    struct LatidoProcesoPar *anterior;
+    struct LatidoProcesoPar *siguiente;
+    unsigned int ranura;
+    unsigned int vueltas;             /* Pasadas por la ranura antes de vencer */
+} LatidoProcesoPar_t;
+
+/**
+ * @brief Estado global de los latidos; `mutex` protege todo lo demás
+ */
+typedef struct Latidor {
+    pthread_mutex_t mutex;
+    pthread_cond_t condicion;         /* Avisa del fin de un relanzamiento */
+    int activo;                       /* 1 si el hilo está en marcha */
+    int fdTemporizador;               /* timerfd que marca los tics */
+    int registrados;                  /* Latidos en la rueda */
+    unsigned long long tic;           /* Último tic procesado */
+    LatidoProcesoPar_t *ranuras[PP_RANURAS_LATIDO];
+} Latidor_t;
+
+extern Latidor_t latidor;
+
+/**
+ * @brief Pone un latido en la rueda y arranca el hilo si no estaba en marcha
+ *
+ * Sustituye al latido que tuviera el proceso par.
+ */
+Estado_t registrarLatidoProcesoPar(LatidoProcesoPar_t *latido);
+
+/**
+ * @brief Quita el latido de un proceso par, si lo tiene, y lo libera
+ *
+ * Si el hijo se está relanzando, espera a que termine.
+ */
+void desregistrarLatidoProcesoPar(ProcesoPar_t *pp);
+
+/**
+ * @brief Anota un mensaje recibido (con pp->mutexLlamadas)
+ * @return 1 si era la respuesta a la sonda y no debe entregarse
+ */
+int anotarMensajeLatido(LatidoProcesoPar_t *latido, const char *mensaje, int longitud);
+#endif
+
+/* ============================================================================
+ * CAPTURA DE TRÁFICO (captura.c, solo Linux)
+ *
+ * Anillo de bytes con varios productores (el hilo que envía y el de
+ * escucha) y un consumidor (el hilo de volcado). Cada productor reserva
+ * espacio avanzando `cabeza` con CAS, copia su registro y lo publica
+ * escribiendo al final su tamaño en la primera palabra. El volcador
+ * consume en orden, pone a cero lo consumido y avanza `cola`.
+ * ============================================================================ */
+
+#ifndef _WIN32
+/* Cada registro del anillo: palabra de estado, relleno, RegistroCaptura_t y
+ * mensaje, redondeado a 8 bytes para que la palabra nunca quede partida */
+#define PP_CABECERA_ANILLO 8
+
+typedef struct CapturaProcesoPar {
+    unsigned long long cabeza;        /* Bytes reservados por los productores */
+    char separacion1[PP_LINEA_CACHE - sizeof(unsigned long long)];
+    unsigned long long cola;          /* Bytes consumidos por el volcador */
+    char separacion2[PP_LINEA_CACHE - sizeof(unsigned long long)];
+    unsigned long long descartados;   /* Mensajes que no cupieron */
+    char *anillo;
+    size_t capacidad;                 /* Potencia de dos */
+    int fd;                           /* Archivo de captura */
+    int detener;                      /* Petición de parada al volcador */
+    pthread_t hilo;                   /* Hilo de volcado */
+} CapturaProcesoPar_t;
+
+/**
+ * @brief Hilo que vuelca el anillo de captura al archivo
+ */
+void *hiloVolcadoCaptura(void *param);
+
+/**
+ * @brief Anota un mensaje en el anillo de captura (sin cerrojos)
+ */
+void capturarMensaje(ProcesoPar_t *pp, int sentido, const char *mensaje, int longitud);
+
+/* Comprobación barata, sin operaciones atómicas de escritura, antes de capturar */
+#define PP_CAPTURAR(pp, sentido, mensaje, longitud) do { \
+    if (__atomic_load_n(&(pp)->captura, __ATOMIC_RELAXED) != NULL) { \
+        capturarMensaje((pp), (sentido), (mensaje), (longitud)); \
+    } \
+} while (0)
+#endif
+
+/* ============================================================================
+ * DIARIO DE ENVÍOS (diario.c, solo Linux)
+ *
+ * Cada segmento es un archivo proyectado con MAP_SHARED: una cabecera y
+ * registros alineados a 8 bytes. Los envíos anotan con mutexEnvio tomado,
+ * el mismo cerrojo que ordena la escritura en la tubería, así que hay un
+ * solo productor a la vez: avanza sin CAS una palabra que lleva el
+ * desplazamiento y el número de registros, la secuencia de cada registro
+ * sale de la propia reserva y el orden en el archivo es el de las
+ * secuencias y el de la tubería. Un registro se publica escribiendo al
+ * final su longitud, que es lo que miran el hilo del diario y el reenvío.
+ * Quien encuentra el segmento lleno lo cierra y, con el mutex del diario,
+ * pone en marcha el repuesto que el hilo del diario tiene preparado; se da
+ * una vez por segmento.
+ * ============================================================================ */
+
+#ifndef _WIN32
+#include <stdint.h>
+
+#define PP_CABECERA_DIARIO 64                 /* Bytes reservados para la cabecera de un segmento */
+#define PP_SEGMENTO_MAXIMO (1U << 30)         /* El desplazamiento cabe en 31 bits */
+
+/* Palabra de reserva: bit 63 cerrado, bits 32-62 desplazamiento, bits 0-31 registros */
+#define PP_DIARIO_CERRADO (1ULL << 63)
+#define PP_DIARIO_DESPLAZAMIENTO(reserva) ((size_t)(((reserva) >> 32) & 0x7FFFFFFFULL))
+#define PP_DIARIO_REGISTROS(reserva) ((reserva) & 0xFFFFFFFFULL)
+
+typedef struct CabeceraDiario {
+    char magia[4];                    /* PROCESOPAR_MAGIA_DIARIO */
+    uint32_t version;                 /* PROCESOPAR_VERSION_DIARIO */
+    uint64_t primeraSecuencia;        /* Secuencia del primer registro */
+} CabeceraDiario_t;
+
+typedef struct RegistroDiario {
+    uint32_t longitud;                /* Bytes del mensaje; se escribe el último (0: sin publicar) */
+    uint32_t reservado;
+    uint64_t secuencia;
+} RegistroDiario_t;
+
+/* Archivo estado.ppd: hasta dónde confirmó el hijo */
+typedef struct EstadoArchivoDiario {
+    char magia[4];
+    uint32_t version;
+    uint64_t confirmada;
+} EstadoArchivoDiario_t;
+
+typedef struct SegmentoDiario {
+    unsigned long long reserva;       /* Palabra de reserva (la avanza quien anota, con mutexEnvio) */
+    unsigned long long publicados;    /* Registros ya publicados */
+    char *mapa;                       /* Archivo proyectado (NULL una vez retirado) */
+    size_t capacidad;
+    int fd;
+    unsigned long long primeraSecuencia;
+    char nombre[32];                  /* Nombre dentro del directorio del diario */
+    size_t escaneado;                 /* Hasta aquí, registros publicados (hilo del diario) */
+    size_t sincronizado;              /* Hasta aquí, pasado a disco (hilo del diario) */
+    struct SegmentoDiario *siguiente; /* Del más antiguo al activo */
+} SegmentoDiario_t;
+
+typedef struct DiarioProcesoPar {
+    SegmentoDiario_t *activo;         /* Segmento en el que se anota */
+    char separacion[PP_LINEA_CACHE - sizeof(SegmentoDiario_t*)];
+    pthread_mutex_t mutex;            /* Rotación, lista de segmentos y repuesto */
+    pthread_cond_t condicion;         /* Despierta al hilo del diario */
+    SegmentoDiario_t *primero;        /* Segmentos en disco */
+    SegmentoDiario_t *repuesto;       /* Preparado para la siguiente rotación, o NULL */
+    SegmentoDiario_t *retirados;      /* Ya borrados; se liberan al cerrar */
+    EstadoArchivoDiario_t *estado;    /* estado.ppd proyectado */
+    int fdEstado;
+    int fdDirectorio;
+    unsigned int repuestos;           /* Para nombrar los repuestos */
+    int directorioCambiado;           /* Hubo renombrados o borrados sin fsync del directorio */
+    size_t bytesSegmento;
+    unsigned long long nsSincronizacion;
+    int confirmarRespuestas;
+    int detener;                      /* Petición de parada al hilo */
+    pthread_t hilo;
+    unsigned long long sincronizaciones;
+    unsigned long long reenviados;
+} DiarioProcesoPar_t;
+
+/**
+ * @brief Abre (o crea) el diario de un directorio; no lo asocia a ningún proceso par
+ */
+Estado_t abrirDiario(const char *directorio, const OpcionesDiario_t *opciones,
+                     DiarioProcesoPar_t **diario);
+
+/**
+ * @brief Detiene el hilo, pasa a disco lo pendiente y libera el diario
+ */
+void cerrarDiario(DiarioProcesoPar_t *d);
+
+/**
+ * @brief Anota un mensaje en el diario del proceso par
+ *
+ * Debe llamarse con pp->mutexEnvio tomado, junto con la escritura del mensaje.
+ *
+ * @return E_OK, también si el proceso par no tiene diario
+ */
+Estado_t anotarDiario(ProcesoPar_t *pp, const char *mensaje, int longitud);
+
+/**
+ * @brief Reenvía por orden lo anotado y no confirmado
+ *
+ * Con tramas debe llamarse con pp->mutexEnvio tomado.
+ */
+void reenviarDiario(ProcesoPar_t *pp, DiarioProcesoPar_t *d);
+
+/**
+ * @brief Con confirmarRespuestas, confirma el mensaje anotado más antiguo sin confirmar
+ */
+void confirmarRespuestaDiario(ProcesoPar_t *pp);
+
+/**
+ * @brief Sube la secuencia confirmada hasta `secuencia` (sin cerrojos)
+ */
+void confirmarHastaDiario(DiarioProcesoPar_t *d, unsigned long long secuencia);
+
+/**
+ * @brief Secuencia del último mensaje anotado (0 si no hay ninguno)
+ */
+unsigned long long ultimaSecuenciaDiario(DiarioProcesoPar_t *d);
+
+/**
+ * @brief Escribe un mensaje sin anotarlo en el diario (enviarMensajeProcesoPar.c)
+ *
+ * Con tramas debe llamarse con pp->mutexEnvio tomado.
+ */
+Estado_t reescribirMensajeProcesoPar(ProcesoPar_t *pp, const char *mensaje, int longitud);
+
+/* SIGPIPE bloqueado en el hilo que escribe a un hijo (enviarMensajeProcesoPar.c) */
+typedef struct SigpipeBloqueado {
+    sigset_t anterior;    /* Máscara del hilo antes de bloquearlo */
+    int pendiente;        /* 1 si ya había un SIGPIPE pendiente que no es nuestro */
+} SigpipeBloqueado_t;
+
+/**
+ * @brief Bloquea SIGPIPE en el hilo que llama antes de escribir en una tubería
+ *
+ * Escribir a un hijo muerto devuelve EPIPE en vez de terminar el proceso,
+ * sin tocar la acción de SIGPIPE del proceso.
+ */
+void bloquearSigpipe(SigpipeBloqueado_t *b);
+
+/**
+ * @brief Descarta el SIGPIPE que dejó pendiente un EPIPE y restaura la máscara
+ *
+ * Conserva errno.
+ */
+void desbloquearSigpipe(const SigpipeBloqueado_t *b, int huboEpipe);
+#endif
+
+/* Contadores compartidos entre hilos: sumas relajadas sin cerrojo */
+#define PP_SUMAR(variable, cantidad) \
+    __atomic_fetch_add(&(variable), (unsigned long long)(cantidad), __ATOMIC_RELAXED)
+#define PP_LEER(variable) __atomic_load_n(&(variable), __ATOMIC_RELAXED)
+
+/* Tamaño de lectura por defecto, igual que el buffer original del hilo */
+#define PP_TAMANO_LECTURA 4096
+
+/**
+ * @brief Bytes que se piden en cada lectura de la tubería
+ *
+ * Con tramas o delimitador se lee en bloques mayores: una lectura puede
+ * contener un mensaje grande o cientos de líneas que se separan de una vez.
+ */
+static inline size_t tamanoLectura(const ProcesoPar_t *pp) {
+    return (pp->compresion || pp->delimitador >= 0) ? 16 * PP_TAMANO_LECTURA : PP_TAMANO_LECTURA - 1;
+}
+
+/**
+ * @brief Reloj monotónico en nanosegundos
+ */
+static inline unsigned long long tiempoNs(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frecuencia, contador;
+    QueryPerformanceFrequency(&frecuencia);
+    QueryPerformanceCounter(&contador);
+    return (unsigned long long)(contador.QuadPart * 1000000000.0 / frecuencia.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+/* ============================================================================
+ * BUFFER DE ENTRADA (procesarEntrada.c)
+ * ============================================================================ */
+
+/**
+ * @brief Amplía un buffer dinámico hasta al menos `necesaria` bytes
+ * @return 1 si el buffer tiene la capacidad pedida, 0 si no hay memoria
+ */
+int asegurarCapacidad(char **buffer, size_t *capacidad, size_t necesaria);
+
+/**
+ * @brief Reserva espacio libre al final de bufferEntrada
+ *
+ * Compacta los bytes ya consumidos y amplía el buffer si hace falta.
+ * Siempre deja un byte extra para poder terminar el mensaje con '\0'.
+ *
+ * @param pp Proceso par
+ * @param minimo Bytes libres que se quieren tener disponibles
+ * @param disponible Bytes que realmente pueden escribirse en el puntero devuelto
+ * @return Puntero al espacio libre, o NULL si no hay memoria
+ */
+char *reservarEntrada(ProcesoPar_t *pp, size_t minimo, size_t *disponible);
+
+/**
+ * @brief Extrae el siguiente mensaje completo de bufferEntrada
+ *
+ * Sin tramas, el mensaje es todo lo pendiente (igual que un read()), hasta
+ * `maximo` bytes, o hasta el delimitador incluido si el proceso par tiene
+ * uno (entonces `maximo` no se aplica). Con compresión negociada, es la siguiente trama completa,
+ * ya descomprimida (`maximo` no se aplica: una trama no se parte).
+ * El mensaje queda terminado en '\0' y es válido hasta la siguiente llamada.
+ *
+ * @return 1 si hay mensaje, 0 si faltan datos, -1 si la trama es inválida
+ */
+int extraerMensaje(ProcesoPar_t *pp, size_t maximo, const char **mensaje, int *longitud);
+
+/**
+ * @brief Indica si extraerMensaje() devolvería un mensaje sin leer más
+ */
+int hayMensajeCompleto(const ProcesoPar_t *pp);
+
+#ifndef _WIN32
+/**
+ * @brief Lee todo lo disponible en la tubería (descriptor en modo no bloqueante)
+ * @return 1 si leyó algo, 0 si no había nada, -1 si el hijo cerró la tubería
+ */
+int leerEntradaNoBloqueante(ProcesoPar_t *pp);
+
+/**
+ * @brief Pasa el proceso par a modo de sondeo (obtenerDescriptorLecturaProcesoPar.c)
+ * @return E_OK, o E_MODO si ya tiene hilo de escucha
+ */
+Estado_t activarModoSondeo(ProcesoPar_t *pp);
+#endif
+
+/**
+ * @brief Libera los buffers de entrada, mensaje y envío
+ */
+void liberarBuffersProcesoPar(ProcesoPar_t *pp);
+
+#endif /* PROCESOPAR_INTERNO_H */
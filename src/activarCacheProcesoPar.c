@@ -0,0 +1,64 @@
+/**
+ * @file activarCacheProcesoPar.c
+ * @brief Implementación de la activación de la caché de respuestas
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+
+/* Cubetas iniciales; la tabla se duplica al llenarse */
+#define CUBETAS_INICIALES 64
+
+/**
+ * @brief Activa (o reconfigura) la caché de respuestas de llamarProcesoPar()
+ */
+Estado_t activarCacheProcesoPar(ProcesoPar_t *procesoPar, size_t bytesMaximos, int msVida) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || msVida < 0) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    (void)bytesMaximos;
+    return E_NO_SOPORTADO;
+#else
+    if (bytesMaximos == 0) {
+        bytesMaximos = PROCESOPAR_CACHE_BYTES;
+    }
+    if (msVida == 0) {
+        msVida = PROCESOPAR_CACHE_MS;
+    }
+
+    pthread_mutex_lock(&procesoPar->mutexLlamadas);
+
+    CacheRespuestas_t *cache = procesoPar->cache;
+    if (cache == NULL) {
+        cache = (CacheRespuestas_t*)calloc(1, sizeof(CacheRespuestas_t));
+        if (cache == NULL) {
+            pthread_mutex_unlock(&procesoPar->mutexLlamadas);
+            return E_NO_MEMORIA;
+        }
+        cache->cubetas = (EntradaCache_t**)calloc(CUBETAS_INICIALES, sizeof(EntradaCache_t*));
+        if (cache->cubetas == NULL) {
+            free(cache);
+            pthread_mutex_unlock(&procesoPar->mutexLlamadas);
+            return E_NO_MEMORIA;
+        }
+        cache->numCubetas = CUBETAS_INICIALES;
+        procesoPar->cache = cache;
+    } else {
+        vaciarCacheRespuestas(cache);
+    }
+
+    cache->bytesMaximos = bytesMaximos;
+    cache->nsVida = (unsigned long long)msVida * 1000000ULL;
+
+    pthread_mutex_unlock(&procesoPar->mutexLlamadas);
+    return E_OK;
+#endif
+}
@@ -0,0 +1,80 @@
+/**
+ * @file activarDiarioProcesoPar.c
+ * @brief Implementación de la activación del diario de envíos de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Activa el modo duradero: los envíos se anotan antes en un diario
+ */
+Estado_t activarDiarioProcesoPar(
+    ProcesoPar_t *procesoPar,
+    const char *directorio,
+    const OpcionesDiario_t *opciones
+) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || directorio == NULL) {
+        return E_PAR_INC;
+    }
+    if (opciones != NULL &&
+        (opciones->bytesSegmento > PP_SEGMENTO_MAXIMO || opciones->msSincronizacion < 0)) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    if (procesoPar->diario != NULL) {
+        return E_MODO;
+    }
+
+    /* Las confirmaciones automáticas llegan por el hilo de escucha */
+    pthread_mutex_lock(&procesoPar->mutexOrden);
+    Estado_t estado = E_OK;
+    if (procesoPar->modoSondeo) {
+        estado = E_MODO;
+    } else if (!procesoPar->hiloCreado) {
+        estado = crearHiloEscucha(procesoPar);
+    }
+    pthread_mutex_unlock(&procesoPar->mutexOrden);
+    if (estado != E_OK) {
+        return estado;
+    }
+
+    DiarioProcesoPar_t *d = NULL;
+    estado = abrirDiario(directorio, opciones, &d);
+    if (estado != E_OK) {
+        return estado;
+    }
+
+    /* Lo que quedó sin confirmar de una ejecución anterior va antes que
+     * cualquier envío anotado en este diario */
+    pthread_mutex_lock(&procesoPar->mutexOrden);
+    pthread_mutex_lock(&procesoPar->mutexEnvio);
+    DiarioProcesoPar_t *ninguno = NULL;
+    if (__atomic_compare_exchange_n(&procesoPar->diario, &ninguno, d, 0,
+                                    __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        reenviarDiario(procesoPar, d);
+        d = NULL;
+    }
+    pthread_mutex_unlock(&procesoPar->mutexEnvio);
+    pthread_mutex_unlock(&procesoPar->mutexOrden);
+
+    /* Otro hilo lo activó a la vez */
+    if (d != NULL) {
+        cerrarDiario(d);
+        return E_MODO;
+    }
+    return E_OK;
+#endif
+}
@@ -0,0 +1,95 @@
+/**
+ * @file activarLatidoProcesoPar.c
+ * @brief Implementación de la activación del latido de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Activa (o reconfigura) la vigilancia por latido de un proceso par
+ */
+Estado_t activarLatidoProcesoPar(ProcesoPar_t *procesoPar, const OpcionesLatido_t *opciones) {
+    /* Validar parámetros */
+    if (procesoPar == NULL) {
+        return E_PAR_INC;
+    }
+
+    OpcionesLatido_t o;
+    memset(&o, 0, sizeof(o));
+    if (opciones != NULL) {
+        o = *opciones;
+    }
+    if (o.msIntervalo < 0 || o.fallosMaximos < 0 ||
+        (o.sonda != NULL && o.longitudSonda <= 0) ||
+        (o.respuesta != NULL && o.longitudRespuesta <= 0)) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    if (o.sonda == NULL) {
+        o.sonda = PROCESOPAR_SONDA_LATIDO;
+        o.longitudSonda = (int)strlen(PROCESOPAR_SONDA_LATIDO);
+    }
+    if (o.respuesta == NULL) {
+        o.respuesta = o.sonda;
+        o.longitudRespuesta = o.longitudSonda;
+    }
+    if (o.msIntervalo == 0) {
+        o.msIntervalo = PROCESOPAR_MS_LATIDO;
+    }
+    if (o.fallosMaximos == 0) {
+        o.fallosMaximos = PROCESOPAR_FALLOS_LATIDO;
+    }
+
+    /* Las respuestas a las sondas las recibe el hilo de escucha */
+    pthread_mutex_lock(&procesoPar->mutexOrden);
+    Estado_t estado = E_OK;
+    if (procesoPar->modoSondeo) {
+        estado = E_MODO;
+    } else if (!procesoPar->hiloCreado) {
+        estado = crearHiloEscucha(procesoPar);
+    }
+    pthread_mutex_unlock(&procesoPar->mutexOrden);
+    if (estado != E_OK) {
+        return estado;
+    }
+
+    /* Sonda y respuesta van en la misma reserva que el latido */
+    LatidoProcesoPar_t *l = (LatidoProcesoPar_t*)calloc(1, sizeof(LatidoProcesoPar_t) +
+                                                        (size_t)o.longitudSonda +
+                                                        (size_t)o.longitudRespuesta);
+    if (l == NULL) {
+        return E_NO_MEMORIA;
+    }
+    l->pp = procesoPar;
+    l->sonda = (char*)(l + 1);
+    memcpy(l->sonda, o.sonda, (size_t)o.longitudSonda);
+    l->longitudSonda = o.longitudSonda;
+    l->respuesta = l->sonda + o.longitudSonda;
+    memcpy(l->respuesta, o.respuesta, (size_t)o.longitudRespuesta);
+    l->longitudRespuesta = o.longitudRespuesta;
+    l->tics = (unsigned int)((o.msIntervalo + PP_MS_TIC_LATIDO - 1) / PP_MS_TIC_LATIDO);
+    l->fallosMaximos = o.fallosMaximos;
+    l->funcion = o.funcion;
+    l->relanzar = o.relanzar;
+
+    estado = registrarLatidoProcesoPar(l);
+    if (estado != E_OK) {
+        free(l);
+    }
+    return estado;
+#endif
+}
@@ -0,0 +1,159 @@
+/**
+ * @file actualizarGrupoProcesoPar.c
+ * @brief Implementación de la sustitución por tandas de los hijos de un grupo
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+#ifndef _WIN32
+/**
+ * @brief Lanza una tanda de hijos y espera a que todos estén listos
+ *
+ * Se lanzan todos antes de esperar al primero para que arranquen a la vez.
+ * Si alguno falla, se destruye la tanda completa.
+ */
+static Estado_t lanzarTanda(
+    MiembroGrupo_t **nuevos,
+    int tanda,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    const OpcionesReemplazo_t *reemplazo
+) {
+    Estado_t estado = E_OK;
+
+    for (int i = 0; i < tanda; i++) {
+        nuevos[i] = NULL;
+    }
+    for (int i = 0; i < tanda && estado == E_OK; i++) {
+        nuevos[i] = (MiembroGrupo_t*)calloc(1, sizeof(MiembroGrupo_t));
+        if (nuevos[i] == NULL) {
+            estado = E_NO_MEMORIA;
+        } else {
+            estado = lanzarProcesoParConOpciones(nombreArchivoEjecutable, listaLineaComando,
+                                                 opciones, &nuevos[i]->pp);
+        }
+    }
+    for (int i = 0; i < tanda && estado == E_OK; i++) {
+        estado = esperarListoProcesoPar(nuevos[i]->pp, reemplazo);
+        if (estado == E_OK) {
+            estado = crearHiloEscucha(nuevos[i]->pp);
+        }
+    }
+
+    if (estado != E_OK) {
+        for (int i = 0; i < tanda; i++) {
+            if (nuevos[i] != NULL && nuevos[i]->pp != NULL) {
+                destruirProcesoPar(nuevos[i]->pp);
+            }
+            free(nuevos[i]);
+            nuevos[i] = NULL;
+        }
+    }
+    return estado;
+}
+
+/**
+ * @brief Quita un miembro del reparto (con grupo->mutex)
+ */
+static void quitarDelReparto(GrupoProcesoPar_t *grupo, MiembroGrupo_t *miembro) {
+    for (int i = 0; i < grupo->numero; i++) {
+        if (grupo->miembros[i] == miembro) {
+            grupo->miembros[i] = grupo->miembros[--grupo->numero];
+            return;
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Sustituye todos los procesos pares del grupo por un nuevo ejecutable
+ */
+Estado_t actualizarGrupoProcesoPar(
+    GrupoProcesoPar_t *grupo,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    const OpcionesReemplazo_t *reemplazo
+) {
+    /* Validar parámetros */
+    if (grupo == NULL || nombreArchivoEjecutable == NULL || listaLineaComando == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    (void)opciones;
+    (void)reemplazo;
+    return E_NO_SOPORTADO;
+#else
+    if (!opcionesReemplazoValidas(reemplazo)) {
+        return E_PAR_INC;
+    }
+
+    pthread_mutex_lock(&grupo->mutexActualizacion);
+
+    /* Los miembros actuales son los que hay que sustituir */
+    pthread_mutex_lock(&grupo->mutex);
+    int total = grupo->numero;
+    MiembroGrupo_t **antiguos = (MiembroGrupo_t**)malloc((size_t)total * sizeof(MiembroGrupo_t*));
+    if (antiguos != NULL) {
+        for (int i = 0; i < total; i++) {
+            antiguos[i] = grupo->miembros[i];
+        }
+    }
+    pthread_mutex_unlock(&grupo->mutex);
+
+    int exceso = (reemplazo != NULL && reemplazo->exceso > 0) ? reemplazo->exceso : 1;
+    if (exceso > total) {
+        exceso = total;
+    }
+    MiembroGrupo_t **nuevos = (MiembroGrupo_t**)malloc((size_t)exceso * sizeof(MiembroGrupo_t*));
+
+    if (antiguos == NULL || nuevos == NULL) {
+        free(antiguos);
+        free(nuevos);
+        pthread_mutex_unlock(&grupo->mutexActualizacion);
+        return E_NO_MEMORIA;
+    }
+
+    Estado_t estado = E_OK;
+    for (int hechos = 0; hechos < total; ) {
+        int tanda = (total - hechos < exceso) ? total - hechos : exceso;
+
+        estado = lanzarTanda(nuevos, tanda, nombreArchivoEjecutable, listaLineaComando,
+                             opciones, reemplazo);
+        if (estado != E_OK) {
+            break;
+        }
+
+        /* Primero entran los nuevos y después salen los antiguos: el
+         * reparto nunca tiene menos miembros que al empezar */
+        pthread_mutex_lock(&grupo->mutex);
+        for (int i = 0; i < tanda; i++) {
+            grupo->miembros[grupo->numero++] = nuevos[i];
+        }
+        for (int i = 0; i < tanda; i++) {
+            quitarDelReparto(grupo, antiguos[hechos + i]);
+        }
+        pthread_mutex_unlock(&grupo->mutex);
+
+        /* La tanda siguiente no empieza hasta que esta quede drenada */
+        unsigned long long limite = limiteReemplazo(reemplazo != NULL ? reemplazo->msDrenaje : 0,
+                                                    PROCESOPAR_MS_DRENAJE);
+        for (int i = 0; i < tanda; i++) {
+            retirarMiembroGrupo(grupo, antiguos[hechos + i], limite);
+        }
+        hechos += tanda;
+    }
+
+    free(nuevos);
+    free(antiguos);
+    pthread_mutex_unlock(&grupo->mutexActualizacion);
+    return estado;
+#endif
+}
@@ -0,0 +1,187 @@
+/**
+ * @file buscarDelimitadores.c
+ * @brief Búsqueda vectorizada de delimitadores (AVX2/SSE2 con respaldo escalar)
+ *
+ * La implementación se elige una vez, en la primera llamada, según la CPU:
+ * AVX2 compara 32 bytes por instrucción, SSE2 (siempre presente en x86-64)
+ * 16, y en otras arquitecturas se recorre con memchr. Cada bloque produce
+ * una máscara de coincidencias de la que se extraen todas las posiciones,
+ * así un bloque con varias líneas cortas cuesta lo mismo que uno sin ninguna.
+ */
+
+#include "ProcesoParInterno.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define PP_X86 1
+#endif
+
+typedef int (*Buscador_t)(const char *datos, size_t longitud, char delimitador,
+                          uint32_t *posiciones, int maximo, size_t *revisados);
+
+/**
+ * @brief Respaldo escalar: memchr repetido
+ */
+static int buscarEscalar(const char *datos, size_t longitud, char delimitador,
+                         uint32_t *posiciones, int maximo, size_t *revisados) {
+    int n = 0;
+    size_t i = 0;
+    while (i < longitud) {
+        const char *p = (const char*)memchr(datos + i, delimitador, longitud - i);
+        if (p == NULL) {
+            break;
+        }
+        posiciones[n++] = (uint32_t)(p - datos);
+        i = (size_t)(p - datos) + 1;
+        if (n == maximo) {
+            *revisados = i;
+            return n;
+        }
+    }
+    *revisados = longitud;
+    return n;
+}
+
+#ifdef PP_X86
+
+/* Anota las posiciones de una máscara de coincidencias; devuelve 1 si se llenó `posiciones` */
+#define PP_EXTRAER_MASCARA(mascara, base) do { \
+    while (mascara != 0) { \
+        size_t posicion = (base) + (size_t)__builtin_ctz(mascara); \
+        posiciones[n++] = (uint32_t)posicion; \
+        mascara &= mascara - 1; \
+        if (n == maximo) { \
+            *revisados = posicion + 1; \
+            return n; \
+        } \
+    } \
+} while (0)
+
+/**
+ * @brief SSE2: 16 bytes por comparación, dos bloques por vuelta
+ */
+__attribute__((target("sse2")))
+static int buscarSse2(const char *datos, size_t longitud, char delimitador,
+                      uint32_t *posiciones, int maximo, size_t *revisados) {
+    const __m128i objetivo = _mm_set1_epi8(delimitador);
+    int n = 0;
+    size_t i = 0;
+
+    for (; i + 32 <= longitud; i += 32) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(datos + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(datos + i + 16));
+        unsigned int mascara = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, objetivo)) |
+                               ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(b, objetivo)) << 16);
+        PP_EXTRAER_MASCARA(mascara, i);
+    }
+
+    for (; i < longitud; i++) {
+        if (datos[i] == delimitador) {
+            posiciones[n++] = (uint32_t)i;
+            if (n == maximo) {
+                *revisados = i + 1;
+                return n;
+            }
+        }
+    }
+
+    *revisados = longitud;
+    return n;
+}
+
+/**
+ * @brief AVX2: 32 bytes por comparación, cuatro bloques por vuelta
+ */
+__attribute__((target("avx2")))
+static int buscarAvx2(const char *datos, size_t longitud, char delimitador,
+                      uint32_t *posiciones, int maximo, size_t *revisados) {
+    const __m256i objetivo = _mm256_set1_epi8(delimitador);
+    int n = 0;
+    size_t i = 0;
+
+    for (; i + 128 <= longitud; i += 128) {
+        __m256i c0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datos + i)), objetivo);
+        __m256i c1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datos + i + 32)), objetivo);
+        __m256i c2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datos + i + 64)), objetivo);
+        __m256i c3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datos + i + 96)), objetivo);
+
+        /* Sin coincidencias en 128 bytes: una sola prueba */
+        __m256i alguna = _mm256_or_si256(_mm256_or_si256(c0, c1), _mm256_or_si256(c2, c3));
+        if (_mm256_testz_si256(alguna, alguna)) {
+            continue;
+        }
+
+        unsigned int mascara = (unsigned int)_mm256_movemask_epi8(c0);
+        PP_EXTRAER_MASCARA(mascara, i);
+        mascara = (unsigned int)_mm256_movemask_epi8(c1);
+        PP_EXTRAER_MASCARA(mascara, i + 32);
+        mascara = (unsigned int)_mm256_movemask_epi8(c2);
+        PP_EXTRAER_MASCARA(mascara, i + 64);
+        mascara = (unsigned int)_mm256_movemask_epi8(c3);
+        PP_EXTRAER_MASCARA(mascara, i + 96);
+    }
+
+    /* Resto (menos de 128 bytes) con SSE2 */
+    size_t revisadosResto;
+    int m = buscarSse2(datos + i, longitud - i, delimitador, posiciones + n, maximo - n, &revisadosResto);
+    for (int k = n; k < n + m; k++) {
+        posiciones[k] += (uint32_t)i;
+    }
+    *revisados = i + revisadosResto;
+    return n + m;
+}
+
+#endif
+
+/* Implementación elegida en la primera llamada */
+static Buscador_t buscador = NULL;
+
+/**
+ * @brief Elige la mejor implementación para esta CPU
+ */
+static Buscador_t elegirBuscador(void) {
+#ifdef PP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return buscarAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return buscarSse2;
+    }
+#endif
+    return buscarEscalar;
+}
+
+/**
+ * @brief Busca en bloque las posiciones de un delimitador
+ */
+Estado_t buscarDelimitadores(
+    const char *datos,
+    size_t longitud,
+    int delimitador,
+    uint32_t *posiciones,
+    int maximo,
+    int *numero,
+    size_t *revisados
+) {
+    /* Validar parámetros */
+    if ((datos == NULL && longitud > 0) || delimitador < 0 || delimitador > 255 ||
+        posiciones == NULL || maximo <= 0 || numero == NULL || longitud > UINT32_MAX) {
+        return E_PAR_INC;
+    }
+
+    /* Varias hebras pueden elegir a la vez: todas eligen lo mismo */
+    Buscador_t f = __atomic_load_n(&buscador, __ATOMIC_RELAXED);
+    if (f == NULL) {
+        f = elegirBuscador();
+        __atomic_store_n(&buscador, f, __ATOMIC_RELAXED);
+    }
+
+    size_t hasta;
+    *numero = f(datos, longitud, (char)delimitador, posiciones, maximo, &hasta);
+    if (revisados != NULL) {
+        *revisados = hasta;
+    }
+    return E_OK;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file cacheRespuestas.c
+ * @brief Tabla hash con lista LRU para la caché de respuestas de llamarProcesoPar()
+ *
+ * Todas las funciones se llaman con pp->mutexLlamadas tomado.
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+
+/* Memoria que se atribuye a cada entrada además de clave y respuesta */
+#define BYTES_ENTRADA(e) (sizeof(EntradaCache_t) + (size_t)(e)->longitudClave + (size_t)(e)->longitudRespuesta)
+
+unsigned long long hashClaveCache(const char *clave, int longitud) {
+    /* FNV-1a de 64 bits */
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < longitud; i++) {
+        hash ^= (unsigned char)clave[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+EntradaCache_t *buscarEntradaCache(CacheRespuestas_t *cache, const char *clave,
+                                   int longitud, unsigned long long hash) {
+    EntradaCache_t *e = cache->cubetas[hash & (cache->numCubetas - 1)];
+    while (e != NULL) {
+        if (e->hash == hash && e->longitudClave == longitud &&
+            memcmp(e->clave, clave, (size_t)longitud) == 0) {
+            return e;
+        }
+        e = e->siguienteHash;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Duplica las cubetas cuando hay más entradas que cubetas
+ */
+static void ampliarCubetas(CacheRespuestas_t *cache) {
+    size_t numero = cache->numCubetas * 2;
+    EntradaCache_t **cubetas = (EntradaCache_t**)calloc(numero, sizeof(EntradaCache_t*));
+    if (cubetas == NULL) {
+        /* Sin memoria las cadenas solo se alargan */
+        return;
+    }
+
+    for (size_t i = 0; i < cache->numCubetas; i++) {
+        EntradaCache_t *e = cache->cubetas[i];
+        while (e != NULL) {
+            EntradaCache_t *siguiente = e->siguienteHash;
+            size_t j = e->hash & (numero - 1);
+            e->siguienteHash = cubetas[j];
+            cubetas[j] = e;
+            e = siguiente;
+        }
+    }
+
+    free(cache->cubetas);
+    cache->cubetas = cubetas;
+    cache->numCubetas = numero;
+}
+
+/**
+ * @brief Quita una entrada de la lista LRU
+ */
+static void desenlazarLru(CacheRespuestas_t *cache, EntradaCache_t *e) {
+    if (e->anterior != NULL) {
+        e->anterior->siguiente = e->siguiente;
+    } else {
+        cache->masReciente = e->siguiente;
+    }
+    if (e->siguiente != NULL) {
+        e->siguiente->anterior = e->anterior;
+    } else {
+        cache->menosReciente = e->anterior;
+    }
+    e->anterior = NULL;
+    e->siguiente = NULL;
+}
+
+/**
+ * @brief Pone una entrada no enlazada al frente de la lista LRU
+ */
+static void enlazarLru(CacheRespuestas_t *cache, EntradaCache_t *e) {
+    e->siguiente = cache->masReciente;
+    if (cache->masReciente != NULL) {
+        cache->masReciente->anterior = e;
+    }
+    cache->masReciente = e;
+    if (cache->menosReciente == NULL) {
+        cache->menosReciente = e;
+    }
+}
+
+void usarEntradaCache(CacheRespuestas_t *cache, EntradaCache_t *e) {
+    if (cache->masReciente == e) {
+        return;
+    }
+    desenlazarLru(cache, e);
+    enlazarLru(cache, e);
+}
+
+EntradaCache_t *insertarEntradaCache(CacheRespuestas_t *cache, const char *clave,
+                                     int longitud, unsigned long long hash,
+                                     LlamadaPendiente_t *llamada) {
+    EntradaCache_t *e = (EntradaCache_t*)calloc(1, sizeof(EntradaCache_t));
+    if (e == NULL) {
+        return NULL;
+    }
+    e->clave = (char*)malloc((size_t)longitud);
+    if (e->clave == NULL) {
+        free(e);
+        return NULL;
+    }
+    memcpy(e->clave, clave, (size_t)longitud);
+    e->longitudClave = longitud;
+    e->hash = hash;
+    e->llamada = llamada;
+
+    size_t i = hash & (cache->numCubetas - 1);
+    e->siguienteHash = cache->cubetas[i];
+    cache->cubetas[i] = e;
+    enlazarLru(cache, e);
+
+    cache->estadisticas.entradas++;
+    cache->estadisticas.bytes += BYTES_ENTRADA(e);
+    if (cache->estadisticas.entradas > cache->numCubetas) {
+        ampliarCubetas(cache);
+    }
+    return e;
+}
+
+void quitarEntradaCache(CacheRespuestas_t *cache, EntradaCache_t *e) {
+    EntradaCache_t **enlace = &cache->cubetas[e->hash & (cache->numCubetas - 1)];
+    while (*enlace != e) {
+        enlace = &(*enlace)->siguienteHash;
+    }
+    *enlace = e->siguienteHash;
+    desenlazarLru(cache, e);
+
+    /* Una llamada en curso ya no debe rellenar esta entrada */
+    if (e->llamada != NULL) {
+        e->llamada->entrada = NULL;
+    }
+
+    cache->estadisticas.entradas--;
+    cache->estadisticas.bytes -= BYTES_ENTRADA(e);
+    free(e->clave);
+    free(e);
+}
+
+/**
+ * @brief Expulsa las entradas menos usadas hasta volver al límite de memoria
+ *
+ * Las entradas en curso no se expulsan: otras llamadas pueden estar
+ * esperándolas.
+ */
+static void expulsar(CacheRespuestas_t *cache) {
+    EntradaCache_t *e = cache->menosReciente;
+    while (e != NULL && cache->estadisticas.bytes > cache->bytesMaximos) {
+        EntradaCache_t *anterior = e->anterior;
+        if (e->llamada == NULL) {
+            quitarEntradaCache(cache, e);
+            cache->estadisticas.expulsiones++;
+        }
+        e = anterior;
+    }
+}
+
+int guardarRespuestaCache(CacheRespuestas_t *cache, EntradaCache_t *e,
+                          const char *respuesta, int longitud) {
+    /* Clave y respuesta comparten reserva */
+    char *datos = (char*)realloc(e->clave, (size_t)e->longitudClave + (size_t)longitud);
+    if (datos == NULL) {
+        e->llamada = NULL;
+        quitarEntradaCache(cache, e);
+        return 0;
+    }
+
+    e->clave = datos;
+    e->respuesta = datos + e->longitudClave;
+    memcpy(e->respuesta, respuesta, (size_t)longitud);
+    e->longitudRespuesta = longitud;
+    e->nsCaducidad = tiempoNs() + cache->nsVida;
+    e->llamada = NULL;
+
+    cache->estadisticas.bytes += (size_t)longitud;
+    expulsar(cache);
+    return 1;
+}
+
+void vaciarCacheRespuestas(CacheRespuestas_t *cache) {
+    EntradaCache_t *e = cache->masReciente;
+    while (e != NULL) {
+        EntradaCache_t *siguiente = e->siguiente;
+        if (e->llamada == NULL) {
+            quitarEntradaCache(cache, e);
+        }
+        e = siguiente;
+    }
+}
+
+#endif
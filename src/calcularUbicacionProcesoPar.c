@@ -0,0 +1,81 @@
+/**
+ * @file calcularUbicacionProcesoPar.c
+ * @brief Implementación del cálculo de ubicación disperso/compacto para grupos de pares
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+
+/**
+ * @brief Calcula la CPU y el nodo NUMA del par número `indice` de un grupo
+ */
+Estado_t calcularUbicacionProcesoPar(int indice, int modo, int *cpu, int *nodo) {
+    /* Validar parámetros */
+    if (indice < 0 || cpu == NULL ||
+        (modo != PROCESOPAR_UBICACION_DISPERSA && modo != PROCESOPAR_UBICACION_COMPACTA)) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    (void)nodo;
+    return E_NO_SOPORTADO;
+#else
+    int numCpus[PP_MAX_NODOS];
+    int numNodos = contarNodosNuma();
+    int total = 0;
+
+    int (*lista)[PP_MAX_CPUS] = (int (*)[PP_MAX_CPUS])malloc(sizeof(int) * PP_MAX_CPUS * (size_t)numNodos);
+    if (lista == NULL) {
+        return E_NO_MEMORIA;
+    }
+
+    for (int n = 0; n < numNodos; n++) {
+        numCpus[n] = leerCpusNodo(n, lista[n], PP_MAX_CPUS);
+        if (numCpus[n] < 0) {
+            numCpus[n] = 0;
+        }
+        total += numCpus[n];
+    }
+
+    if (total == 0) {
+        free(lista);
+        return E_NO_SOPORTADO;
+    }
+
+    int posicion = indice % total;
+    int elegido = -1, nodoElegido = -1;
+
+    if (modo == PROCESOPAR_UBICACION_COMPACTA) {
+        /* Recorrer los nodos en orden, CPU a CPU */
+        for (int n = 0; n < numNodos && elegido < 0; n++) {
+            if (posicion < numCpus[n]) {
+                elegido = lista[n][posicion];
+                nodoElegido = n;
+            } else {
+                posicion -= numCpus[n];
+            }
+        }
+    } else {
+        /* Intercalar: la ronda r toma la CPU r de cada nodo que la tenga */
+        for (int ronda = 0; elegido < 0; ronda++) {
+            for (int n = 0; n < numNodos && elegido < 0; n++) {
+                if (ronda < numCpus[n]) {
+                    if (posicion == 0) {
+                        elegido = lista[n][ronda];
+                        nodoElegido = n;
+                    }
+                    posicion--;
+                }
+            }
+        }
+    }
+
+    free(lista);
+
+    *cpu = elegido;
+    if (nodo != NULL) {
+        *nodo = nodoElegido;
+    }
+    return E_OK;
+#endif
+}
@@ -0,0 +1,190 @@
+/**
+ * @file captura.c
+ * @brief Anillo de captura sin cerrojos y su hilo de volcado
+ */
+
+#include "ProcesoParInterno.h"
+#include <string.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <errno.h>
+    #include <time.h>
+#endif
+
+#ifndef _WIN32
+
+/* Periodo del hilo de volcado */
+#define MS_VOLCADO 10
+
+/* Bytes que el volcador acumula antes de escribir */
+#define TAMANO_ESCRITURA (64 * 1024)
+
+/**
+ * @brief Copia bytes al anillo a partir de una posición, dando la vuelta si hace falta
+ */
+static void copiarAlAnillo(CapturaProcesoPar_t *c, unsigned long long posicion,
+                           const void *datos, size_t longitud) {
+    size_t inicio = (size_t)(posicion & (c->capacidad - 1));
+    size_t primero = c->capacidad - inicio;
+    if (primero > longitud) {
+        primero = longitud;
+    }
+    memcpy(c->anillo + inicio, datos, primero);
+    memcpy(c->anillo, (const char*)datos + primero, longitud - primero);
+}
+
+/**
+ * @brief Copia bytes del anillo a partir de una posición, dando la vuelta si hace falta
+ */
+static void copiarDelAnillo(const CapturaProcesoPar_t *c, unsigned long long posicion,
+                            void *destino, size_t longitud) {
+    size_t inicio = (size_t)(posicion & (c->capacidad - 1));
+    size_t primero = c->capacidad - inicio;
+    if (primero > longitud) {
+        primero = longitud;
+    }
+    memcpy(destino, c->anillo + inicio, primero);
+    memcpy((char*)destino + primero, c->anillo, longitud - primero);
+}
+
+/**
+ * @brief Pone a cero un tramo del anillo
+ */
+static void limpiarAnillo(CapturaProcesoPar_t *c, unsigned long long posicion, size_t longitud) {
+    size_t inicio = (size_t)(posicion & (c->capacidad - 1));
+    size_t primero = c->capacidad - inicio;
+    if (primero > longitud) {
+        primero = longitud;
+    }
+    memset(c->anillo + inicio, 0, primero);
+    memset(c->anillo, 0, longitud - primero);
+}
+
+void capturarMensaje(ProcesoPar_t *pp, int sentido, const char *mensaje, int longitud) {
+    /* Mientras usuariosCaptura no sea cero, detenerCapturaProcesoPar no libera la captura */
+    /* SEQ_CST en ambos lados: el incremento no puede ordenarse tras la lectura
+     * del puntero, ni el intercambio tras la lectura del contador */
+    __atomic_fetch_add(&pp->usuariosCaptura, 1, __ATOMIC_SEQ_CST);
+    CapturaProcesoPar_t *c = __atomic_load_n(&pp->captura, __ATOMIC_SEQ_CST);
+
+    if (c != NULL) {
+        RegistroCaptura_t registro;
+        memset(&registro, 0, sizeof(registro));
+        registro.ns = tiempoNs();
+        registro.longitud = (uint32_t)longitud;
+        registro.sentido = (uint8_t)sentido;
+
+        size_t total = (PP_CABECERA_ANILLO + sizeof(registro) + (size_t)longitud + 7) & ~(size_t)7;
+
+        /* Reservar espacio; si no cabe, descartar en vez de esperar */
+        unsigned long long cabeza = __atomic_load_n(&c->cabeza, __ATOMIC_RELAXED);
+        int reservado = 0;
+        while (!reservado) {
+            unsigned long long cola = __atomic_load_n(&c->cola, __ATOMIC_ACQUIRE);
+            if (cabeza + total - cola > c->capacidad) {
+                break;
+            }
+            reservado = __atomic_compare_exchange_n(&c->cabeza, &cabeza, cabeza + total, 1,
+                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        }
+
+        if (reservado) {
+            copiarAlAnillo(c, cabeza + PP_CABECERA_ANILLO, &registro, sizeof(registro));
+            copiarAlAnillo(c, cabeza + PP_CABECERA_ANILLO + sizeof(registro), mensaje, (size_t)longitud);
+
+            /* Publicar: la palabra de estado está alineada y nunca se parte */
+            uint32_t *estado = (uint32_t*)(c->anillo + (cabeza & (c->capacidad - 1)));
+            __atomic_store_n(estado, (uint32_t)total, __ATOMIC_RELEASE);
+        } else {
+            PP_SUMAR(c->descartados, 1);
+        }
+    }
+
+    __atomic_fetch_sub(&pp->usuariosCaptura, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Escribe un buffer completo en el archivo de captura
+ */
+static void escribirTodo(int fd, const char *datos, size_t longitud) {
+    while (longitud > 0) {
+        ssize_t escritos = write(fd, datos, longitud);
+        if (escritos == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        datos += escritos;
+        longitud -= (size_t)escritos;
+    }
+}
+
+/**
+ * @brief Vuelca al archivo todos los registros ya publicados
+ */
+static void volcar(CapturaProcesoPar_t *c, char *salida) {
+    size_t usados = 0;
+    unsigned long long cola = c->cola;
+
+    for (;;) {
+        /* Un registro reservado pero sin publicar detiene el volcado hasta la siguiente vuelta */
+        uint32_t *estado = (uint32_t*)(c->anillo + (cola & (c->capacidad - 1)));
+        uint32_t total = __atomic_load_n(estado, __ATOMIC_ACQUIRE);
+        if (total == 0) {
+            break;
+        }
+
+        RegistroCaptura_t registro;
+        copiarDelAnillo(c, cola + PP_CABECERA_ANILLO, &registro, sizeof(registro));
+        size_t bytes = sizeof(registro) + registro.longitud;
+
+        if (usados + bytes > TAMANO_ESCRITURA) {
+            escribirTodo(c->fd, salida, usados);
+            usados = 0;
+        }
+        if (bytes > TAMANO_ESCRITURA) {
+            /* Mensaje mayor que el buffer de salida: escribirlo por partes */
+            char parte[4096];
+            for (size_t hecho = 0; hecho < bytes; ) {
+                size_t n = (bytes - hecho < sizeof(parte)) ? bytes - hecho : sizeof(parte);
+                copiarDelAnillo(c, cola + PP_CABECERA_ANILLO + hecho, parte, n);
+                escribirTodo(c->fd, parte, n);
+                hecho += n;
+            }
+        } else {
+            copiarDelAnillo(c, cola + PP_CABECERA_ANILLO, salida + usados, bytes);
+            usados += bytes;
+        }
+
+        /* Dejar el tramo a cero antes de devolverlo a los productores */
+        limpiarAnillo(c, cola, total);
+        cola += total;
+        __atomic_store_n(&c->cola, cola, __ATOMIC_RELEASE);
+    }
+
+    if (usados > 0) {
+        escribirTodo(c->fd, salida, usados);
+    }
+}
+
+void *hiloVolcadoCaptura(void *param) {
+    CapturaProcesoPar_t *c = (CapturaProcesoPar_t*)param;
+    char salida[TAMANO_ESCRITURA];
+
+    struct timespec periodo;
+    periodo.tv_sec = 0;
+    periodo.tv_nsec = MS_VOLCADO * 1000000L;
+
+    while (!__atomic_load_n(&c->detener, __ATOMIC_ACQUIRE)) {
+        volcar(c, salida);
+        nanosleep(&periodo, NULL);
+    }
+
+    /* Lo publicado antes de la parada */
+    volcar(c, salida);
+    return NULL;
+}
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * @file comprimirPPLZ.c
+ * @brief Implementación del compresor PPLZ
+ *
+ * PPLZ usa el formato de bloque de LZ4: una secuencia de (token, literales,
+ * desplazamiento de 16 bits, longitud de coincidencia). El token lleva en su
+ * nibble alto la longitud de literales y en el bajo la de la coincidencia
+ * menos 4; el valor 15 indica que siguen bytes de extensión (255 = continúa).
+ */
+
+#include "ProcesoParInterno.h"
+#include <string.h>
+
+#define PPLZ_BITS_HASH          12        /* Tabla de 4096 posiciones (16 KB en pila) */
+#define PPLZ_MIN_COINCIDENCIA   4         /* Coincidencia mínima codificable */
+#define PPLZ_LIMITE_COINCIDENCIA 12       /* Ninguna coincidencia empieza tan cerca del final */
+#define PPLZ_LITERALES_FINALES  5         /* Los últimos bytes siempre van como literales */
+#define PPLZ_DISTANCIA_MAXIMA   65535     /* Desplazamiento máximo (16 bits) */
+#define PPLZ_SALTO_INICIAL      6         /* Acelera la búsqueda en datos incompresibles */
+
+static uint32_t leer32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t hashPPLZ(uint32_t v) {
+    return (v * 2654435761u) >> (32 - PPLZ_BITS_HASH);
+}
+
+/**
+ * @brief Escribe una longitud de extensión (bytes 255 seguidos del resto)
+ */
+static unsigned char *escribirExtension(unsigned char *op, size_t longitud) {
+    while (longitud >= 255) {
+        *op++ = 255;
+        longitud -= 255;
+    }
+    *op++ = (unsigned char)longitud;
+    return op;
+}
+
+/**
+ * @brief Emite una secuencia completa; devuelve NULL si no cabe en destino
+ */
+static unsigned char *emitirSecuencia(
+    unsigned char *op, const unsigned char *opFin,
+    const unsigned char *literales, size_t numLiterales,
+    size_t desplazamiento, size_t longitudCoincidencia, int final
+) {
+    /* Peor caso: token + extensiones + literales + desplazamiento */
+    size_t necesario = 1 + numLiterales / 255 + 1 + numLiterales + 2 + longitudCoincidencia / 255 + 1;
+    if ((size_t)(opFin - op) < necesario) {
+        return NULL;
+    }
+
+    unsigned char *token = op++;
+
+    if (numLiterales >= 15) {
+        *token = 15 << 4;
+        op = escribirExtension(op, numLiterales - 15);
+    } else {
+        *token = (unsigned char)(numLiterales << 4);
+    }
+
+    memcpy(op, literales, numLiterales);
+    op += numLiterales;
+
+    if (final) {
+        return op;
+    }
+
+    *op++ = (unsigned char)(desplazamiento & 0xFF);
+    *op++ = (unsigned char)(desplazamiento >> 8);
+
+    size_t extra = longitudCoincidencia - PPLZ_MIN_COINCIDENCIA;
+    if (extra >= 15) {
+        *token |= 15;
+        op = escribirExtension(op, extra - 15);
+    } else {
+        *token |= (unsigned char)extra;
+    }
+
+    return op;
+}
+
+/**
+ * @brief Comprime un bloque con el códec PPLZ
+ */
+Estado_t comprimirPPLZ(
+    const char *origen,
+    int longitud,
+    char *destino,
+    int capacidad,
+    int *longitudComprimida
+) {
+    /* Validar parámetros */
+    if (origen == NULL || destino == NULL || longitudComprimida == NULL ||
+        longitud < 0 || capacidad < 0) {
+        return E_PAR_INC;
+    }
+
+    const unsigned char *inicio = (const unsigned char*)origen;
+    const unsigned char *fin = inicio + longitud;
+    const unsigned char *ip = inicio;
+    const unsigned char *ancla = inicio;   /* Primer literal aún no emitido */
+    unsigned char *op = (unsigned char*)destino;
+    const unsigned char *opFin = op + capacidad;
+
+    if (longitud > PPLZ_LIMITE_COINCIDENCIA) {
+        uint32_t tabla[1 << PPLZ_BITS_HASH];
+        memset(tabla, 0, sizeof(tabla));
+
+        const unsigned char *limite = fin - PPLZ_LIMITE_COINCIDENCIA;
+        const unsigned char *limiteExtension = fin - PPLZ_LITERALES_FINALES;
+        unsigned int intentos = 1 << PPLZ_SALTO_INICIAL;
+
+        while (ip < limite) {
+            uint32_t secuencia = leer32(ip);
+            uint32_t h = hashPPLZ(secuencia);
+            const unsigned char *ref = inicio + tabla[h];
+            tabla[h] = (uint32_t)(ip - inicio);
+
+            if (ref >= ip || ip - ref > PPLZ_DISTANCIA_MAXIMA || leer32(ref) != secuencia) {
+                /* Sin coincidencia: avanzar más deprisa cuanto más tiempo se falle */
+                ip += intentos++ >> PPLZ_SALTO_INICIAL;
+                continue;
+            }
+
+            /* Extender la coincidencia hacia atrás sobre los literales pendientes */
+            while (ip > ancla && ref > inicio && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+
+            /* Extender hacia delante */
+            const unsigned char *p = ip + PPLZ_MIN_COINCIDENCIA;
+            const unsigned char *q = ref + PPLZ_MIN_COINCIDENCIA;
+            while (p < limiteExtension && *p == *q) {
+                p++;
+                q++;
+            }
+
+            op = emitirSecuencia(op, opFin, ancla, (size_t)(ip - ancla),
+                                 (size_t)(ip - ref), (size_t)(p - ip), 0);
+            if (op == NULL) {
+                return E_NO_MEMORIA;
+            }
+
+            ip = p;
+            ancla = ip;
+            intentos = 1 << PPLZ_SALTO_INICIAL;
+
+            /* Registrar una posición dentro de la coincidencia para la siguiente */
+            if (ip < limite) {
+                tabla[hashPPLZ(leer32(ip - 2))] = (uint32_t)(ip - 2 - inicio);
+            }
+        }
+    }
+
+    /* Últimos literales */
+    op = emitirSecuencia(op, opFin, ancla, (size_t)(fin - ancla), 0, 0, 1);
+    if (op == NULL) {
+        return E_NO_MEMORIA;
+    }
+
+    *longitudComprimida = (int)(op - (unsigned char*)destino);
+    return E_OK;
+}
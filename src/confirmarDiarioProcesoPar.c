@@ -0,0 +1,34 @@
+/**
+ * @file confirmarDiarioProcesoPar.c
+ * @brief Implementación de la confirmación explícita de mensajes del diario
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Confirma todos los mensajes anotados hasta una secuencia
+ */
+Estado_t confirmarDiarioProcesoPar(ProcesoPar_t *procesoPar, unsigned long long secuencia) {
+    /* Validar parámetros */
+    if (procesoPar == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    (void)secuencia;
+    return E_NO_SOPORTADO;
+#else
+    Estado_t estado = E_PAR_INC;
+
+    __atomic_fetch_add(&procesoPar->usuariosDiario, 1, __ATOMIC_SEQ_CST);
+    DiarioProcesoPar_t *d = __atomic_load_n(&procesoPar->diario, __ATOMIC_SEQ_CST);
+    if (d != NULL && secuencia <= ultimaSecuenciaDiario(d)) {
+        /* El hilo del diario la pasa a disco y borra lo ya confirmado */
+        confirmarHastaDiario(d, secuencia);
+        estado = E_OK;
+    }
+    __atomic_fetch_sub(&procesoPar->usuariosDiario, 1, __ATOMIC_RELEASE);
+
+    return estado;
+#endif
+}
@@ -0,0 +1,113 @@
+/**
+ * @file crearGrupoProcesoPar.c
+ * @brief Implementación de la creación de un grupo de procesos pares
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <time.h>
+#endif
+
+/**
+ * @brief Crea un grupo de procesos pares iguales
+ */
+Estado_t crearGrupoProcesoPar(
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    const OpcionesReemplazo_t *reemplazo,
+    int numero,
+    GrupoProcesoPar_t **grupo
+) {
+    /* Validar parámetros */
+    if (nombreArchivoEjecutable == NULL || listaLineaComando == NULL || numero <= 0 ||
+        grupo == NULL) {
+        return E_PAR_INC;
+    }
+
+    *grupo = NULL;
+
+#ifdef _WIN32
+    (void)opciones;
+    (void)reemplazo;
+    return E_NO_SOPORTADO;
+#else
+    if (!opcionesReemplazoValidas(reemplazo)) {
+        return E_PAR_INC;
+    }
+
+    /* Una actualización llega a tener `numero` hijos de más */
+    GrupoProcesoPar_t *g = (GrupoProcesoPar_t*)calloc(1, sizeof(GrupoProcesoPar_t));
+    EspecificacionProcesoPar_t *especificaciones =
+        (EspecificacionProcesoPar_t*)calloc((size_t)numero, sizeof(EspecificacionProcesoPar_t));
+    if (g != NULL) {
+        g->capacidad = 2 * numero;
+        g->miembros = (MiembroGrupo_t**)calloc((size_t)g->capacidad, sizeof(MiembroGrupo_t*));
+    }
+    if (g == NULL || g->miembros == NULL || especificaciones == NULL) {
+        if (g != NULL) {
+            free(g->miembros);
+        }
+        free(g);
+        free(especificaciones);
+        return E_NO_MEMORIA;
+    }
+
+    for (int i = 0; i < numero; i++) {
+        especificaciones[i].nombreArchivoEjecutable = nombreArchivoEjecutable;
+        especificaciones[i].listaLineaComando = listaLineaComando;
+        especificaciones[i].opciones = opciones;
+    }
+
+    /* Lanzar todos a la vez y después esperar a cada uno */
+    Estado_t estado = lanzarLoteProcesoPar(especificaciones, numero, 0, NULL);
+    for (int i = 0; i < numero && estado == E_OK; i++) {
+        ProcesoPar_t *pp = especificaciones[i].procesoPar;
+        estado = esperarListoProcesoPar(pp, reemplazo);
+
+        /* El hilo de escucha vacía la tubería aunque nadie llame */
+        if (estado == E_OK) {
+            estado = crearHiloEscucha(pp);
+        }
+        if (estado == E_OK) {
+            g->miembros[i] = (MiembroGrupo_t*)calloc(1, sizeof(MiembroGrupo_t));
+            if (g->miembros[i] == NULL) {
+                estado = E_NO_MEMORIA;
+            } else {
+                g->miembros[i]->pp = pp;
+            }
+        }
+    }
+
+    if (estado != E_OK) {
+        for (int i = 0; i < numero; i++) {
+            if (especificaciones[i].procesoPar != NULL) {
+                destruirProcesoPar(especificaciones[i].procesoPar);
+            }
+            free(g->miembros[i]);
+        }
+        free(g->miembros);
+        free(g);
+        free(especificaciones);
+        return estado;
+    }
+    free(especificaciones);
+
+    g->numero = numero;
+    pthread_mutex_init(&g->mutex, NULL);
+    pthread_mutex_init(&g->mutexActualizacion, NULL);
+
+    /* El retiro espera con plazos del reloj monotónico */
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_cond_init(&g->condicion, &atributos);
+    pthread_condattr_destroy(&atributos);
+
+    *grupo = g;
+    return E_OK;
+#endif
+}
@@ -0,0 +1,37 @@
+/**
+ * @file desactivarDiarioProcesoPar.c
+ * @brief Implementación del cierre del diario de envíos de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <sched.h>
+#endif
+
+/**
+ * @brief Pasa a disco lo anotado y cierra el diario, conservando sus archivos
+ */
+Estado_t desactivarDiarioProcesoPar(ProcesoPar_t *procesoPar) {
+    /* Validar parámetro */
+    if (procesoPar == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    DiarioProcesoPar_t *d = __atomic_exchange_n(&procesoPar->diario, NULL, __ATOMIC_SEQ_CST);
+    if (d == NULL) {
+        return E_PAR_INC;
+    }
+
+    /* Esperar a los hilos que ya tenían el diario */
+    while (__atomic_load_n(&procesoPar->usuariosDiario, __ATOMIC_SEQ_CST) != 0) {
+        sched_yield();
+    }
+
+    cerrarDiario(d);
+    return E_OK;
+#endif
+}
@@ -0,0 +1,23 @@
+/**
+ * @file desactivarLatidoProcesoPar.c
+ * @brief Implementación de la desactivación del latido de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Deja de vigilar un proceso par por latido
+ */
+Estado_t desactivarLatidoProcesoPar(ProcesoPar_t *procesoPar) {
+    /* Validar parámetro */
+    if (procesoPar == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    desregistrarLatidoProcesoPar(procesoPar);
+    return E_OK;
+#endif
+}
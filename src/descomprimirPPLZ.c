@@ -0,0 +1,111 @@
+/**
+ * @file descomprimirPPLZ.c
+ * @brief Implementación del descompresor PPLZ
+ *
+ * Valida cada longitud y desplazamiento antes de copiar, de modo que un
+ * bloque corrupto nunca lee ni escribe fuera de los buffers.
+ */
+
+#include "ProcesoParInterno.h"
+#include <string.h>
+
+#define PPLZ_MIN_COINCIDENCIA 4
+
+/**
+ * @brief Lee una longitud de extensión; devuelve 0 si el bloque se acaba antes
+ */
+static int leerExtension(const unsigned char **ip, const unsigned char *fin, size_t *longitud) {
+    unsigned char b;
+    do {
+        if (*ip >= fin) {
+            return 0;
+        }
+        b = *(*ip)++;
+        *longitud += b;
+    } while (b == 255);
+    return 1;
+}
+
+/**
+ * @brief Descomprime un bloque PPLZ
+ */
+Estado_t descomprimirPPLZ(
+    const char *origen,
+    int longitud,
+    char *destino,
+    int capacidad,
+    int *longitudOriginal
+) {
+    /* Validar parámetros */
+    if (origen == NULL || destino == NULL || longitudOriginal == NULL ||
+        longitud < 0 || capacidad < 0) {
+        return E_PAR_INC;
+    }
+
+    const unsigned char *ip = (const unsigned char*)origen;
+    const unsigned char *fin = ip + longitud;
+    unsigned char *inicioDestino = (unsigned char*)destino;
+    unsigned char *op = inicioDestino;
+    unsigned char *opFin = op + capacidad;
+
+    while (ip < fin) {
+        unsigned char token = *ip++;
+
+        /* Literales */
+        size_t numLiterales = token >> 4;
+        if (numLiterales == 15 && !leerExtension(&ip, fin, &numLiterales)) {
+            return E_DATOS_CORRUPTOS;
+        }
+        if (numLiterales > (size_t)(fin - ip) || numLiterales > (size_t)(opFin - op)) {
+            return E_DATOS_CORRUPTOS;
+        }
+        memcpy(op, ip, numLiterales);
+        op += numLiterales;
+        ip += numLiterales;
+
+        /* La última secuencia solo tiene literales */
+        if (ip == fin) {
+            break;
+        }
+
+        /* Coincidencia */
+        if (fin - ip < 2) {
+            return E_DATOS_CORRUPTOS;
+        }
+        size_t desplazamiento = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (desplazamiento == 0 || desplazamiento > (size_t)(op - inicioDestino)) {
+            return E_DATOS_CORRUPTOS;
+        }
+
+        size_t longitudCoincidencia = token & 15;
+        if (longitudCoincidencia == 15 && !leerExtension(&ip, fin, &longitudCoincidencia)) {
+            return E_DATOS_CORRUPTOS;
+        }
+        longitudCoincidencia += PPLZ_MIN_COINCIDENCIA;
+        if (longitudCoincidencia > (size_t)(opFin - op)) {
+            return E_DATOS_CORRUPTOS;
+        }
+
+        const unsigned char *ref = op - desplazamiento;
+        if (desplazamiento >= longitudCoincidencia) {
+            memcpy(op, ref, longitudCoincidencia);
+            op += longitudCoincidencia;
+        } else {
+            /* Solapamiento: el patrón se repite con periodo `desplazamiento`;
+             * cada copia duplica el tramo ya escrito que puede reutilizarse */
+            while (longitudCoincidencia > 0) {
+                size_t tramo = (size_t)(op - ref);
+                if (tramo > longitudCoincidencia) {
+                    tramo = longitudCoincidencia;
+                }
+                memcpy(op, ref, tramo);
+                op += tramo;
+                longitudCoincidencia -= tramo;
+            }
+        }
+    }
+
+    *longitudOriginal = (int)(op - inicioDestino);
+    return E_OK;
+}
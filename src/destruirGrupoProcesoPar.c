@@ -0,0 +1,41 @@
+/**
+ * @file destruirGrupoProcesoPar.c
+ * @brief Implementación de la destrucción de un grupo de procesos pares
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Destruye todos los procesos pares del grupo y libera el grupo
+ */
+Estado_t destruirGrupoProcesoPar(GrupoProcesoPar_t *grupo) {
+    /* Validar parámetro */
+    if (grupo == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    /* Dejar que termine una actualización en curso */
+    pthread_mutex_lock(&grupo->mutexActualizacion);
+    pthread_mutex_unlock(&grupo->mutexActualizacion);
+
+    for (int i = 0; i < grupo->numero; i++) {
+        destruirProcesoPar(grupo->miembros[i]->pp);
+        free(grupo->miembros[i]);
+    }
+
+    pthread_cond_destroy(&grupo->condicion);
+    pthread_mutex_destroy(&grupo->mutexActualizacion);
+    pthread_mutex_destroy(&grupo->mutex);
+    free(grupo->miembros);
+    free(grupo);
+    return E_OK;
+#endif
+}
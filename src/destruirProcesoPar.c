@@ -3,7 +3,7 @@
  * @brief Implementación de la función para destruir un proceso par y liberar recursos
  */
 
-#include "../include/ProcesoPar.h"
+#include "ProcesoParInterno.h"
 #include <stdlib.h>
 
 #ifdef _WIN32
@@ -12,6 +12,7 @@
     #include <unistd.h>
     #include <signal.h>
     #include <sys/wait.h>
+    #include <pthread.h>
 #endif
 
 /**
@@ -23,9 +24,21 @@ Estado_t destruirProcesoPar(ProcesoPar_t *procesoPar) {
         return E_PAR_INC;
     }
 
+#ifndef _WIN32
+    /* Al volver de la función de escucha, el hilo seguiría usando los
+     * buffers y las llamadas pendientes del proceso par ya liberado */
+    if (procesoPar->hiloCreado && pthread_equal(pthread_self(), procesoPar->hiloEscucha)) {
+        return E_MODO;
+    }
+#endif
+
     /* Marcar el proceso como inactivo */
     procesoPar->activo = 0;
 
+#ifndef _WIN32
+    PP_TRAZA(DESTRUCCION, procesoPar->pid, 0);
+#endif
+
 #ifdef _WIN32
     /* ========================================
      * IMPLEMENTACIÓN PARA WINDOWS
@@ -72,12 +85,13 @@ Estado_t destruirProcesoPar(ProcesoPar_t *procesoPar) {
      * IMPLEMENTACIÓN PARA LINUX
      * ======================================== */
     
-    /* Cerrar tuberías */
-    if (procesoPar->pipeEntrada[0] != -1) {
-        close(procesoPar->pipeEntrada[0]);
-        procesoPar->pipeEntrada[0] = -1;
-    }
+    /* Sin latido, nadie más puede relanzar el hijo ni enviarle sondas */
+    desregistrarLatidoProcesoPar(procesoPar);
 
+    /* Dejar de muestrear antes de que el PID pueda reutilizarse */
+    desregistrarMuestreoProcesoPar(procesoPar);
+
+    /* Cerrar la tubería hacia el hijo */
     if (procesoPar->pipeSalida[1] != -1) {
         close(procesoPar->pipeSalida[1]);
         procesoPar->pipeSalida[1] = -1;
@@ -95,14 +109,43 @@ Estado_t destruirProcesoPar(ProcesoPar_t *procesoPar) {
         procesoPar->pid = -1;
     }
 
-    /* Nota: El hilo de escucha terminará automáticamente cuando se cierren las tuberías
-     * porque es "detached" y la lectura retornará 0 (EOF)
+    /* Con el hijo terminado, la lectura del hilo de escucha retorna 0 (EOF).
+     * Esperarlo antes de liberar los buffers que usa.
      */
+    if (procesoPar->hiloCreado) {
+        pthread_join(procesoPar->hiloEscucha, NULL);
+        procesoPar->hiloCreado = 0;
+    }
+
+    /* Cerrar la tubería desde el hijo */
+    if (procesoPar->pipeEntrada[0] != -1) {
+        close(procesoPar->pipeEntrada[0]);
+        procesoPar->pipeEntrada[0] = -1;
+    }
+
+    /* Sin hilo de escucha ya nadie confirma: cerrar el diario, si lo hay */
+    if (procesoPar->diario != NULL) {
+        desactivarDiarioProcesoPar(procesoPar);
+    }
+
+    /* Sin hilo de escucha ya nadie recibe: cerrar la captura, si la hay */
+    if (procesoPar->captura != NULL) {
+        detenerCapturaProcesoPar(procesoPar, NULL);
+    }
+
+    /* Sin hilo de escucha, ya nadie completa llamadas ni toca la caché */
+    liberarLlamadasProcesoPar(procesoPar);
+    pthread_mutex_destroy(&procesoPar->mutexEnvio);
+    free(procesoPar->cpusEscucha);
+    procesoPar->cpusEscucha = NULL;
+    free(procesoPar->lanzamiento);
+    procesoPar->lanzamiento = NULL;
 
 #endif
 
-    /* Liberar la memoria de la estructura */
-    free(procesoPar);
+    /* Liberar los buffers y la memoria de la estructura */
+    liberarBuffersProcesoPar(procesoPar);
+    liberarProcesoPar(procesoPar);
 
     return E_OK;
 }
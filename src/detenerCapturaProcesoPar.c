@@ -0,0 +1,50 @@
+/**
+ * @file detenerCapturaProcesoPar.c
+ * @brief Implementación del fin de la captura de tráfico de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <sched.h>
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Termina la captura, volcando lo pendiente y cerrando el archivo
+ */
+Estado_t detenerCapturaProcesoPar(ProcesoPar_t *procesoPar, unsigned long long *descartados) {
+    /* Validar parámetros */
+    if (procesoPar == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    (void)descartados;
+    return E_NO_SOPORTADO;
+#else
+    CapturaProcesoPar_t *c = __atomic_exchange_n(&procesoPar->captura, NULL, __ATOMIC_SEQ_CST);
+    if (c == NULL) {
+        return E_PAR_INC;
+    }
+
+    /* Esperar a que terminen los productores que ya tenían la captura */
+    while (__atomic_load_n(&procesoPar->usuariosCaptura, __ATOMIC_SEQ_CST) != 0) {
+        sched_yield();
+    }
+
+    __atomic_store_n(&c->detener, 1, __ATOMIC_RELEASE);
+    pthread_join(c->hilo, NULL);
+    close(c->fd);
+
+    if (descartados != NULL) {
+        *descartados = PP_LEER(c->descartados);
+    }
+
+    free(c->anillo);
+    free(c);
+    return E_OK;
+#endif
+}
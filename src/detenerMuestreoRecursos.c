@@ -0,0 +1,48 @@
+/**
+ * @file detenerMuestreoRecursos.c
+ * @brief Implementación de la parada del hilo muestreador de recursos
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Detiene el hilo muestreador (los registros se conservan)
+ */
+Estado_t detenerMuestreoRecursos(void) {
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    pthread_mutex_lock(&muestreador.mutex);
+
+    /* Otra llamada ya está parando el hilo: esperar a que termine su join */
+    if (muestreador.activo && muestreador.detener) {
+        while (muestreador.activo) {
+            pthread_cond_wait(&muestreador.condicion, &muestreador.mutex);
+        }
+    }
+
+    if (!muestreador.activo) {
+        pthread_mutex_unlock(&muestreador.mutex);
+        return E_OK;
+    }
+
+    muestreador.detener = 1;
+    pthread_cond_broadcast(&muestreador.condicion);
+    pthread_t hilo = muestreador.hilo;
+    pthread_mutex_unlock(&muestreador.mutex);
+
+    pthread_join(hilo, NULL);
+
+    /* activo sigue a 1 hasta aquí: nadie arranca otro hilo mientras
+     * el anterior aún puede esperar en la condición */
+    pthread_mutex_lock(&muestreador.mutex);
+    muestreador.activo = 0;
+    pthread_cond_broadcast(&muestreador.condicion);
+    pthread_mutex_unlock(&muestreador.mutex);
+    return E_OK;
+#endif
+}
@@ -0,0 +1,745 @@
+/**
+ * @file diario.c
+ * @brief Diario de envíos en archivos proyectados y funciones internas asociadas
+ *
+ * Anotar solo copia en memoria: el msync, la preparación del
+ * siguiente archivo y el borrado de lo confirmado los hace el hilo del
+ * diario, por lotes, fuera del camino de envío.
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <dirent.h>
+    #include <time.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#ifndef _WIN32
+
+/**
+ * @brief Bytes que ocupa un registro: cabecera y mensaje, alineado a 8
+ */
+static size_t tamanoRegistro(size_t longitud) {
+    return (sizeof(RegistroDiario_t) + longitud + 7) & ~(size_t)7;
+}
+
+static size_t tamanoPagina(void) {
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Crea un repuesto: archivo con el espacio ya asignado y proyectado
+ *
+ * Todo lo lento (asignar bloques, fallos de página) ocurre aquí, en el
+ * hilo del diario, y no al anotar.
+ */
+static SegmentoDiario_t *crearSegmento(DiarioProcesoPar_t *d) {
+    SegmentoDiario_t *s = (SegmentoDiario_t*)calloc(1, sizeof(SegmentoDiario_t));
+    if (s == NULL) {
+        return NULL;
+    }
+    snprintf(s->nombre, sizeof(s->nombre), "repuesto-%u.ppd",
+             __atomic_fetch_add(&d->repuestos, 1, __ATOMIC_RELAXED));
+    s->capacidad = d->bytesSegmento;
+
+    s->fd = openat(d->fdDirectorio, s->nombre, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (s->fd == -1) {
+        free(s);
+        return NULL;
+    }
+
+    /* Sin posix_fallocate (algunos sistemas de archivos), un archivo disperso */
+    int error = posix_fallocate(s->fd, 0, (off_t)s->capacidad);
+    if (error == EOPNOTSUPP || error == EINVAL) {
+        error = (ftruncate(s->fd, (off_t)s->capacidad) == 0) ? 0 : errno;
+    }
+    if (error == 0) {
+        void *mapa = mmap(NULL, s->capacidad, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, s->fd, 0);
+        if (mapa != MAP_FAILED) {
+            s->mapa = (char*)mapa;
+            return s;
+        }
+    }
+
+    close(s->fd);
+    unlinkat(d->fdDirectorio, s->nombre, 0);
+    free(s);
+    return NULL;
+}
+
+/**
+ * @brief Libera un segmento; con `borrar`, también su archivo
+ */
+static void liberarSegmento(DiarioProcesoPar_t *d, SegmentoDiario_t *s, int borrar) {
+    if (s->mapa != NULL) {
+        munmap(s->mapa, s->capacidad);
+        s->mapa = NULL;
+    }
+    close(s->fd);
+    s->fd = -1;
+    if (borrar) {
+        unlinkat(d->fdDirectorio, s->nombre, 0);
+    }
+}
+
+/**
+ * @brief Da a un repuesto su nombre definitivo y su cabecera
+ * @return 1 si quedó listo para anotar, 0 si no se pudo renombrar
+ */
+static int ponerEnMarcha(DiarioProcesoPar_t *d, SegmentoDiario_t *s, unsigned long long primera) {
+    char nombre[sizeof(s->nombre)];
+    snprintf(nombre, sizeof(nombre), "%016llx.ppd", primera);
+    if (renameat(d->fdDirectorio, s->nombre, d->fdDirectorio, nombre) != 0) {
+        return 0;
+    }
+    memcpy(s->nombre, nombre, sizeof(nombre));
+
+    CabeceraDiario_t *cabecera = (CabeceraDiario_t*)s->mapa;
+    memcpy(cabecera->magia, PROCESOPAR_MAGIA_DIARIO, sizeof(cabecera->magia));
+    cabecera->version = PROCESOPAR_VERSION_DIARIO;
+    cabecera->primeraSecuencia = primera;
+
+    s->primeraSecuencia = primera;
+    s->publicados = 0;
+    s->escaneado = PP_CABECERA_DIARIO;
+    s->sincronizado = 0;
+    s->siguiente = NULL;
+    s->reserva = (unsigned long long)PP_CABECERA_DIARIO << 32;
+    return 1;
+}
+
+/**
+ * @brief Sustituye el segmento activo, que está cerrado y lleno
+ * @return 1 si hay un segmento activo nuevo, 0 si no
+ */
+static int rotarDiario(DiarioProcesoPar_t *d, SegmentoDiario_t *lleno) {
+    int rotado = 1;
+
+    pthread_mutex_lock(&d->mutex);
+
+    SegmentoDiario_t *s = d->repuesto;
+    d->repuesto = NULL;
+    if (s == NULL) {
+        s = crearSegmento(d);
+    }
+
+    unsigned long long reserva = __atomic_load_n(&lleno->reserva, __ATOMIC_RELAXED);
+    if (s != NULL && ponerEnMarcha(d, s, lleno->primeraSecuencia + PP_DIARIO_REGISTROS(reserva))) {
+        __atomic_store_n(&lleno->siguiente, s, __ATOMIC_RELEASE);
+        __atomic_store_n(&d->activo, s, __ATOMIC_RELEASE);
+        d->directorioCambiado = 1;
+    } else {
+        if (s != NULL) {
+            liberarSegmento(d, s, 1);
+            free(s);
+        }
+        rotado = 0;
+    }
+
+    /* El hilo del diario prepara el siguiente repuesto */
+    pthread_cond_signal(&d->condicion);
+
+    pthread_mutex_unlock(&d->mutex);
+    return rotado;
+}
+
+/**
+ * @brief Reserva sitio en el segmento activo y copia el mensaje
+ *
+ * Debe llamarse con mutexEnvio tomado: hay un solo productor a la vez, así
+ * que la reserva avanza sin CAS.
+ */
+static Estado_t anotarEnDiario(DiarioProcesoPar_t *d, const char *mensaje, int longitud) {
+    size_t tamano = tamanoRegistro((size_t)longitud);
+    if (tamano > d->bytesSegmento - PP_CABECERA_DIARIO) {
+        return E_ENVIO_FALLO;
+    }
+
+    for (;;) {
+        SegmentoDiario_t *s = __atomic_load_n(&d->activo, __ATOMIC_ACQUIRE);
+        unsigned long long reserva = __atomic_load_n(&s->reserva, __ATOMIC_RELAXED);
+        size_t desplazamiento = PP_DIARIO_DESPLAZAMIENTO(reserva);
+
+        if (!(reserva & PP_DIARIO_CERRADO) && desplazamiento + tamano <= s->capacidad) {
+            unsigned long long nueva = ((unsigned long long)(desplazamiento + tamano) << 32) |
+                                       (PP_DIARIO_REGISTROS(reserva) + 1);
+            __atomic_store_n(&s->reserva, nueva, __ATOMIC_RELAXED);
+
+            RegistroDiario_t *r = (RegistroDiario_t*)(s->mapa + desplazamiento);
+            r->reservado = 0;
+            r->secuencia = s->primeraSecuencia + PP_DIARIO_REGISTROS(reserva);
+            memcpy(r + 1, mensaje, (size_t)longitud);
+
+            /* La longitud publica el registro */
+            __atomic_store_n(&r->longitud, (uint32_t)longitud, __ATOMIC_RELEASE);
+            __atomic_fetch_add(&s->publicados, 1, __ATOMIC_RELEASE);
+            return E_OK;
+        }
+
+        /* No cabe (o una rotación anterior falló): se cierra y se anota en el siguiente */
+        __atomic_store_n(&s->reserva, reserva | PP_DIARIO_CERRADO, __ATOMIC_RELAXED);
+        if (!rotarDiario(d, s)) {
+            return E_ENVIO_FALLO;
+        }
+    }
+}
+
+/**
+ * @brief Pasa a disco lo publicado desde la última vez (hilo del diario)
+ *
+ * Solo se sincroniza el prefijo de registros publicados de cada segmento:
+ * un registro reservado y aún sin publicar corta el avance hasta el ciclo
+ * siguiente.
+ *
+ * @return Secuencia confirmada que quedó en disco
+ */
+static unsigned long long sincronizarDiario(DiarioProcesoPar_t *d, unsigned long long confirmadaEnDisco) {
+    size_t pagina = tamanoPagina();
+
+    for (SegmentoDiario_t *s = d->primero; s != NULL;
+         s = __atomic_load_n(&s->siguiente, __ATOMIC_ACQUIRE)) {
+        size_t limite = PP_DIARIO_DESPLAZAMIENTO(__atomic_load_n(&s->reserva, __ATOMIC_ACQUIRE));
+        size_t posicion = s->escaneado;
+
+        while (posicion + sizeof(RegistroDiario_t) <= limite) {
+            RegistroDiario_t *r = (RegistroDiario_t*)(s->mapa + posicion);
+            uint32_t longitud = __atomic_load_n(&r->longitud, __ATOMIC_ACQUIRE);
+            if (longitud == 0) {
+                break;
+            }
+            posicion += tamanoRegistro(longitud);
+        }
+        s->escaneado = posicion;
+
+        if (posicion > s->sincronizado) {
+            size_t inicio = s->sincronizado & ~(pagina - 1);
+            msync(s->mapa + inicio, posicion - inicio, MS_SYNC);
+            s->sincronizado = posicion;
+            PP_SUMAR(d->sincronizaciones, 1);
+        }
+    }
+
+    unsigned long long confirmada = __atomic_load_n(&d->estado->confirmada, __ATOMIC_RELAXED);
+    if (confirmada != confirmadaEnDisco) {
+        msync(d->estado, sizeof(EstadoArchivoDiario_t), MS_SYNC);
+    }
+
+    pthread_mutex_lock(&d->mutex);
+    int directorioCambiado = d->directorioCambiado;
+    d->directorioCambiado = 0;
+    pthread_mutex_unlock(&d->mutex);
+    if (directorioCambiado) {
+        fsync(d->fdDirectorio);
+    }
+
+    return confirmada;
+}
+
+/**
+ * @brief Deja un repuesto preparado si no lo hay (hilo del diario)
+ */
+static void prepararRepuesto(DiarioProcesoPar_t *d) {
+    pthread_mutex_lock(&d->mutex);
+    int falta = (d->repuesto == NULL);
+    pthread_mutex_unlock(&d->mutex);
+
+    if (falta) {
+        SegmentoDiario_t *s = crearSegmento(d);
+        if (s != NULL) {
+            pthread_mutex_lock(&d->mutex);
+            if (d->repuesto == NULL) {
+                d->repuesto = s;
+                s = NULL;
+            }
+            pthread_mutex_unlock(&d->mutex);
+        }
+        if (s != NULL) {
+            liberarSegmento(d, s, 1);
+            free(s);
+        }
+    }
+}
+
+/**
+ * @brief Borra los segmentos más antiguos ya confirmados (hilo del diario)
+ *
+ * Un segmento se borra cuando está cerrado, con todos sus registros
+ * publicados y pasados a disco, y su último mensaje está confirmado en el
+ * estado que ya está en disco.
+ */
+static void retirarConfirmados(DiarioProcesoPar_t *d, unsigned long long confirmada) {
+    pthread_mutex_lock(&d->mutex);
+
+    while (d->primero != d->activo) {
+        SegmentoDiario_t *s = d->primero;
+        unsigned long long reserva = __atomic_load_n(&s->reserva, __ATOMIC_ACQUIRE);
+        unsigned long long registros = PP_DIARIO_REGISTROS(reserva);
+
+        if (__atomic_load_n(&s->publicados, __ATOMIC_ACQUIRE) != registros ||
+            s->sincronizado < PP_DIARIO_DESPLAZAMIENTO(reserva) ||
+            s->primeraSecuencia + registros > confirmada + 1) {
+            break;
+        }
+
+        d->primero = s->siguiente;
+        liberarSegmento(d, s, 1);
+        s->siguiente = d->retirados;
+        d->retirados = s;
+        d->directorioCambiado = 1;
+    }
+
+    pthread_mutex_unlock(&d->mutex);
+}
+
+/**
+ * @brief Hilo del diario: sincroniza cada nsSincronizacion o al rotar
+ */
+static void *hiloDiario(void *param) {
+    DiarioProcesoPar_t *d = (DiarioProcesoPar_t*)param;
+    unsigned long long confirmadaEnDisco = __atomic_load_n(&d->estado->confirmada, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&d->mutex);
+    for (;;) {
+        int detener = d->detener;
+        pthread_mutex_unlock(&d->mutex);
+
+        /* Al parar, una última sincronización */
+        confirmadaEnDisco = sincronizarDiario(d, confirmadaEnDisco);
+        if (detener) {
+            return NULL;
+        }
+        prepararRepuesto(d);
+        retirarConfirmados(d, confirmadaEnDisco);
+
+        /* condicion usa el reloj monotónico */
+        struct timespec siguiente;
+        clock_gettime(CLOCK_MONOTONIC, &siguiente);
+        siguiente.tv_sec += (time_t)(d->nsSincronizacion / 1000000000ULL);
+        siguiente.tv_nsec += (long)(d->nsSincronizacion % 1000000000ULL);
+        if (siguiente.tv_nsec >= 1000000000L) {
+            siguiente.tv_sec++;
+            siguiente.tv_nsec -= 1000000000L;
+        }
+
+        /* Una rotación gasta el repuesto: despertar para preparar otro */
+        pthread_mutex_lock(&d->mutex);
+        while (!d->detener && d->repuesto != NULL &&
+               pthread_cond_timedwait(&d->condicion, &d->mutex, &siguiente) != ETIMEDOUT) {
+        }
+    }
+}
+
+/**
+ * @brief Proyecta estado.ppd, creándolo si no existe
+ */
+static Estado_t abrirEstado(DiarioProcesoPar_t *d) {
+    d->fdEstado = openat(d->fdDirectorio, "estado.ppd", O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (d->fdEstado == -1) {
+        return E_PAR_INC;
+    }
+
+    struct stat info;
+    if (fstat(d->fdEstado, &info) == -1) {
+        return E_PAR_INC;
+    }
+    int nuevo = (info.st_size == 0);
+    if (nuevo && ftruncate(d->fdEstado, (off_t)sizeof(EstadoArchivoDiario_t)) == -1) {
+        return E_PAR_INC;
+    }
+    if (!nuevo && info.st_size != (off_t)sizeof(EstadoArchivoDiario_t)) {
+        return E_DATOS_CORRUPTOS;
+    }
+
+    void *mapa = mmap(NULL, sizeof(EstadoArchivoDiario_t), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, d->fdEstado, 0);
+    if (mapa == MAP_FAILED) {
+        return E_PAR_INC;
+    }
+    d->estado = (EstadoArchivoDiario_t*)mapa;
+
+    if (nuevo) {
+        memcpy(d->estado->magia, PROCESOPAR_MAGIA_DIARIO, sizeof(d->estado->magia));
+        d->estado->version = PROCESOPAR_VERSION_DIARIO;
+        d->estado->confirmada = 0;
+        msync(d->estado, sizeof(EstadoArchivoDiario_t), MS_SYNC);
+    } else if (memcmp(d->estado->magia, PROCESOPAR_MAGIA_DIARIO, sizeof(d->estado->magia)) != 0 ||
+               d->estado->version != PROCESOPAR_VERSION_DIARIO) {
+        return E_DATOS_CORRUPTOS;
+    }
+    return E_OK;
+}
+
+/**
+ * @brief Proyecta un segmento de una ejecución anterior y cuenta sus registros
+ *
+ * El segmento queda cerrado: no se anota más en él.
+ */
+static Estado_t cargarSegmento(DiarioProcesoPar_t *d, unsigned long long primera, SegmentoDiario_t **segmento) {
+    SegmentoDiario_t *s = (SegmentoDiario_t*)calloc(1, sizeof(SegmentoDiario_t));
+    if (s == NULL) {
+        return E_NO_MEMORIA;
+    }
+    snprintf(s->nombre, sizeof(s->nombre), "%016llx.ppd", primera);
+
+    s->fd = openat(d->fdDirectorio, s->nombre, O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (s->fd == -1 || fstat(s->fd, &info) == -1) {
+        if (s->fd != -1) {
+            close(s->fd);
+        }
+        free(s);
+        return E_PAR_INC;
+    }
+    if (info.st_size < PP_CABECERA_DIARIO || info.st_size > (off_t)PP_SEGMENTO_MAXIMO) {
+        close(s->fd);
+        free(s);
+        return E_DATOS_CORRUPTOS;
+    }
+    s->capacidad = (size_t)info.st_size;
+
+    void *mapa = mmap(NULL, s->capacidad, PROT_READ, MAP_SHARED, s->fd, 0);
+    if (mapa == MAP_FAILED) {
+        close(s->fd);
+        free(s);
+        return E_PAR_INC;
+    }
+    s->mapa = (char*)mapa;
+
+    Estado_t estado = E_OK;
+    const CabeceraDiario_t *cabecera = (const CabeceraDiario_t*)s->mapa;
+    if (memcmp(cabecera->magia, PROCESOPAR_MAGIA_DIARIO, sizeof(cabecera->magia)) != 0 ||
+        cabecera->version != PROCESOPAR_VERSION_DIARIO || cabecera->primeraSecuencia != primera) {
+        estado = E_DATOS_CORRUPTOS;
+    }
+
+    /* Los registros publicados forman un prefijo: el primero a cero es el final */
+    size_t posicion = PP_CABECERA_DIARIO;
+    unsigned long long registros = 0;
+    while (estado == E_OK && posicion + sizeof(RegistroDiario_t) <= s->capacidad) {
+        const RegistroDiario_t *r = (const RegistroDiario_t*)(s->mapa + posicion);
+        if (r->longitud == 0) {
+            break;
+        }
+        size_t tamano = tamanoRegistro(r->longitud);
+        if (tamano > s->capacidad - posicion || r->secuencia != primera + registros) {
+            estado = E_DATOS_CORRUPTOS;
+            break;
+        }
+        posicion += tamano;
+        registros++;
+    }
+
+    if (estado != E_OK) {
+        liberarSegmento(d, s, 0);
+        free(s);
+        return estado;
+    }
+
+    s->primeraSecuencia = primera;
+    s->reserva = PP_DIARIO_CERRADO | ((unsigned long long)posicion << 32) | registros;
+    s->publicados = registros;
+    s->escaneado = posicion;
+    s->sincronizado = posicion;
+    *segmento = s;
+    return E_OK;
+}
+
+static int compararSecuencias(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a;
+    unsigned long long y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Carga los segmentos del directorio, del más antiguo al más reciente
+ *
+ * Los repuestos de una ejecución anterior y los segmentos vacíos se borran.
+ *
+ * @param ultima Secuencia del último registro encontrado (0 si ninguno)
+ */
+static Estado_t cargarSegmentos(DiarioProcesoPar_t *d, unsigned long long *ultima) {
+    *ultima = 0;
+
+    int fd = dup(d->fdDirectorio);
+    DIR *dir = (fd != -1) ? fdopendir(fd) : NULL;
+    if (dir == NULL) {
+        if (fd != -1) {
+            close(fd);
+        }
+        return E_PAR_INC;
+    }
+
+    unsigned long long *primeras = NULL;
+    size_t numero = 0;
+    size_t capacidad = 0;
+    Estado_t estado = E_OK;
+    struct dirent *entrada;
+
+    while ((entrada = readdir(dir)) != NULL && estado == E_OK) {
+        const char *nombre = entrada->d_name;
+        if (strncmp(nombre, "repuesto-", 9) == 0) {
+            unlinkat(d->fdDirectorio, nombre, 0);
+            continue;
+        }
+        if (strlen(nombre) != 20 || strcmp(nombre + 16, ".ppd") != 0 ||
+            strspn(nombre, "0123456789abcdef") != 16) {
+            continue;
+        }
+        if (numero == capacidad) {
+            size_t nueva = capacidad ? 2 * capacidad : 16;
+            unsigned long long *p = (unsigned long long*)realloc(primeras, nueva * sizeof(*p));
+            if (p == NULL) {
+                estado = E_NO_MEMORIA;
+                break;
+            }
+            primeras = p;
+            capacidad = nueva;
+        }
+        primeras[numero++] = strtoull(nombre, NULL, 16);
+    }
+    closedir(dir);
+
+    qsort(primeras, numero, sizeof(*primeras), compararSecuencias);
+
+    SegmentoDiario_t **final = &d->primero;
+    for (size_t i = 0; i < numero && estado == E_OK; i++) {
+        SegmentoDiario_t *s = NULL;
+        estado = cargarSegmento(d, primeras[i], &s);
+        if (estado != E_OK) {
+            break;
+        }
+
+        /* Una secuencia que no sigue a la anterior: falta un archivo */
+        if (*ultima != 0 && s->primeraSecuencia != *ultima + 1) {
+            liberarSegmento(d, s, 0);
+            free(s);
+            estado = E_DATOS_CORRUPTOS;
+            break;
+        }
+
+        if (s->publicados == 0) {
+            liberarSegmento(d, s, 1);
+            free(s);
+            continue;
+        }
+        *ultima = s->primeraSecuencia + s->publicados - 1;
+        *final = s;
+        final = &s->siguiente;
+    }
+
+    free(primeras);
+    return estado;
+}
+
+/**
+ * @brief Libera todo lo del diario; conserva los archivos salvo el repuesto
+ */
+static void liberarDiario(DiarioProcesoPar_t *d) {
+    SegmentoDiario_t *s = d->primero;
+    while (s != NULL) {
+        SegmentoDiario_t *siguiente = s->siguiente;
+        liberarSegmento(d, s, 0);
+        free(s);
+        s = siguiente;
+    }
+    s = d->retirados;
+    while (s != NULL) {
+        SegmentoDiario_t *siguiente = s->siguiente;
+        free(s);
+        s = siguiente;
+    }
+    if (d->repuesto != NULL) {
+        liberarSegmento(d, d->repuesto, 1);
+        free(d->repuesto);
+    }
+
+    if (d->estado != NULL) {
+        munmap(d->estado, sizeof(EstadoArchivoDiario_t));
+    }
+    if (d->fdEstado != -1) {
+        close(d->fdEstado);
+    }
+    if (d->fdDirectorio != -1) {
+        close(d->fdDirectorio);
+    }
+    pthread_mutex_destroy(&d->mutex);
+    pthread_cond_destroy(&d->condicion);
+    free(d);
+}
+
+Estado_t abrirDiario(const char *directorio, const OpcionesDiario_t *opciones,
+                     DiarioProcesoPar_t **diario) {
+    *diario = NULL;
+
+    DiarioProcesoPar_t *d = (DiarioProcesoPar_t*)calloc(1, sizeof(DiarioProcesoPar_t));
+    if (d == NULL) {
+        return E_NO_MEMORIA;
+    }
+    d->fdEstado = -1;
+    d->fdDirectorio = -1;
+
+    /* Tamaño de segmento en páginas enteras */
+    size_t pagina = tamanoPagina();
+    size_t bytes = (opciones != NULL && opciones->bytesSegmento > 0) ?
+                   opciones->bytesSegmento : PROCESOPAR_DIARIO_BYTES;
+    d->bytesSegmento = (bytes + pagina - 1) & ~(pagina - 1);
+    int ms = (opciones != NULL && opciones->msSincronizacion > 0) ?
+             opciones->msSincronizacion : PROCESOPAR_MS_DIARIO;
+    d->nsSincronizacion = (unsigned long long)ms * 1000000ULL;
+    d->confirmarRespuestas = (opciones != NULL) ? opciones->confirmarRespuestas : 0;
+
+    pthread_mutex_init(&d->mutex, NULL);
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_cond_init(&d->condicion, &atributos);
+    pthread_condattr_destroy(&atributos);
+
+    Estado_t estado = E_OK;
+    if (mkdir(directorio, 0700) == -1 && errno != EEXIST) {
+        estado = E_PAR_INC;
+    }
+    if (estado == E_OK) {
+        d->fdDirectorio = open(directorio, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (d->fdDirectorio == -1) {
+            estado = E_PAR_INC;
+        }
+    }
+    if (estado == E_OK) {
+        estado = abrirEstado(d);
+    }
+
+    unsigned long long ultima = 0;
+    if (estado == E_OK) {
+        estado = cargarSegmentos(d, &ultima);
+    }
+
+    /* El segmento activo continúa la numeración */
+    if (estado == E_OK) {
+        unsigned long long siguiente = ultima + 1;
+        if (siguiente <= d->estado->confirmada) {
+            siguiente = d->estado->confirmada + 1;
+        }
+
+        SegmentoDiario_t *s = crearSegmento(d);
+        if (s == NULL || !ponerEnMarcha(d, s, siguiente)) {
+            if (s != NULL) {
+                liberarSegmento(d, s, 1);
+                free(s);
+            }
+            estado = E_PAR_INC;
+        } else {
+            SegmentoDiario_t **final = &d->primero;
+            while (*final != NULL) {
+                final = &(*final)->siguiente;
+            }
+            *final = s;
+            d->activo = s;
+            d->directorioCambiado = 1;
+        }
+    }
+
+    if (estado == E_OK && pthread_create(&d->hilo, NULL, hiloDiario, d) != 0) {
+        estado = E_CREAR_HILO;
+    }
+
+    if (estado != E_OK) {
+        liberarDiario(d);
+        return estado;
+    }
+
+    *diario = d;
+    return E_OK;
+}
+
+void cerrarDiario(DiarioProcesoPar_t *d) {
+    pthread_mutex_lock(&d->mutex);
+    d->detener = 1;
+    pthread_cond_signal(&d->condicion);
+    pthread_mutex_unlock(&d->mutex);
+    pthread_join(d->hilo, NULL);
+
+    liberarDiario(d);
+}
+
+Estado_t anotarDiario(ProcesoPar_t *pp, const char *mensaje, int longitud) {
+    Estado_t estado = E_OK;
+
+    __atomic_fetch_add(&pp->usuariosDiario, 1, __ATOMIC_SEQ_CST);
+    DiarioProcesoPar_t *d = __atomic_load_n(&pp->diario, __ATOMIC_SEQ_CST);
+    if (d != NULL) {
+        estado = anotarEnDiario(d, mensaje, longitud);
+    }
+    __atomic_fetch_sub(&pp->usuariosDiario, 1, __ATOMIC_RELEASE);
+
+    return estado;
+}
+
+void reenviarDiario(ProcesoPar_t *pp, DiarioProcesoPar_t *d) {
+    pthread_mutex_lock(&d->mutex);
+
+    unsigned long long confirmada = __atomic_load_n(&d->estado->confirmada, __ATOMIC_RELAXED);
+    for (SegmentoDiario_t *s = d->primero; s != NULL; s = s->siguiente) {
+        size_t limite = PP_DIARIO_DESPLAZAMIENTO(__atomic_load_n(&s->reserva, __ATOMIC_ACQUIRE));
+        size_t posicion = PP_CABECERA_DIARIO;
+
+        while (posicion + sizeof(RegistroDiario_t) <= limite) {
+            const RegistroDiario_t *r = (const RegistroDiario_t*)(s->mapa + posicion);
+            uint32_t longitud = __atomic_load_n(&r->longitud, __ATOMIC_ACQUIRE);
+            if (longitud == 0) {
+                break;
+            }
+            if (r->secuencia > confirmada) {
+                if (reescribirMensajeProcesoPar(pp, (const char*)(r + 1), (int)longitud) != E_OK) {
+                    pthread_mutex_unlock(&d->mutex);
+                    return;
+                }
+                PP_SUMAR(d->reenviados, 1);
+            }
+            posicion += tamanoRegistro(longitud);
+        }
+    }
+
+    pthread_mutex_unlock(&d->mutex);
+}
+
+void confirmarHastaDiario(DiarioProcesoPar_t *d, unsigned long long secuencia) {
+    unsigned long long actual = __atomic_load_n(&d->estado->confirmada, __ATOMIC_RELAXED);
+    while (actual < secuencia &&
+           !__atomic_compare_exchange_n(&d->estado->confirmada, &actual, secuencia,
+                                        1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+unsigned long long ultimaSecuenciaDiario(DiarioProcesoPar_t *d) {
+    SegmentoDiario_t *s = __atomic_load_n(&d->activo, __ATOMIC_ACQUIRE);
+    unsigned long long reserva = __atomic_load_n(&s->reserva, __ATOMIC_ACQUIRE);
+    return s->primeraSecuencia + PP_DIARIO_REGISTROS(reserva) - 1;
+}
+
+void confirmarRespuestaDiario(ProcesoPar_t *pp) {
+    __atomic_fetch_add(&pp->usuariosDiario, 1, __ATOMIC_SEQ_CST);
+    DiarioProcesoPar_t *d = __atomic_load_n(&pp->diario, __ATOMIC_SEQ_CST);
+
+    if (d != NULL && d->confirmarRespuestas) {
+        unsigned long long ultima = ultimaSecuenciaDiario(d);
+        unsigned long long actual = __atomic_load_n(&d->estado->confirmada, __ATOMIC_RELAXED);
+        while (actual < ultima &&
+               !__atomic_compare_exchange_n(&d->estado->confirmada, &actual, actual + 1,
+                                            1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        }
+    }
+
+    __atomic_fetch_sub(&pp->usuariosDiario, 1, __ATOMIC_RELEASE);
+}
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file enviarGrupoProcesoPar.c
+ * @brief Implementación del envío por turnos a un grupo de procesos pares
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Envía un mensaje al siguiente proceso par del grupo (por turnos)
+ */
+Estado_t enviarGrupoProcesoPar(GrupoProcesoPar_t *grupo, const char *mensaje, int longitud) {
+    /* Validar parámetros */
+    if (grupo == NULL || mensaje == NULL || longitud <= 0) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    /* El uso anotado impide que una actualización drene el miembro a mitad del envío */
+    MiembroGrupo_t *miembro = tomarMiembroGrupo(grupo);
+    if (miembro == NULL) {
+        return E_PROCESO_INACT;
+    }
+
+    Estado_t estado = enviarMensajeProcesoPar(miembro->pp, mensaje, longitud);
+    soltarMiembroGrupo(grupo, miembro);
+    return estado;
+#endif
+}
@@ -3,13 +3,160 @@
  * @brief Implementación de la función para enviar mensajes al proceso hijo
  */
 
-#include "../include/ProcesoPar.h"
+#include "ProcesoParInterno.h"
 #include <string.h>
 
 #ifdef _WIN32
     #include <windows.h>
 #else
     #include <unistd.h>
+    #include <errno.h>
+    #include <sys/uio.h>
+    #include <pthread.h>
+    #include <signal.h>
+    #include <time.h>
+#endif
+
+#ifndef _WIN32
+void bloquearSigpipe(SigpipeBloqueado_t *b) {
+    sigset_t sigpipe;
+    sigset_t pendientes;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, &b->anterior);
+
+    /* Uno ya pendiente (de otro origen) no se descarta */
+    sigemptyset(&pendientes);
+    sigpending(&pendientes);
+    b->pendiente = sigismember(&pendientes, SIGPIPE) == 1;
+}
+
+void desbloquearSigpipe(const SigpipeBloqueado_t *b, int huboEpipe) {
+    int error = errno;
+
+    if (huboEpipe && !b->pendiente) {
+        sigset_t sigpipe;
+        sigemptyset(&sigpipe);
+        sigaddset(&sigpipe, SIGPIPE);
+        struct timespec cero = { 0, 0 };
+        while (sigtimedwait(&sigpipe, NULL, &cero) == -1 && errno == EINTR) {
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &b->anterior, NULL);
+
+    errno = error;
+}
+
+/**
+ * @brief Escribe una trama completa (cabecera + carga) reintentando escrituras parciales
+ * @return 1 si se escribió entera, 0 en caso de error
+ */
+static int escribirTrama(int fd, const CabeceraTrama_t *cabecera, const char *carga) {
+    struct iovec iov[2];
+    iov[0].iov_base = (void*)cabecera;
+    iov[0].iov_len = sizeof(*cabecera);
+    iov[1].iov_base = (void*)carga;
+    iov[1].iov_len = cabecera->longitud;
+
+    struct iovec *actual = iov;
+    int restantes = 2;
+
+    SigpipeBloqueado_t sigpipe;
+    bloquearSigpipe(&sigpipe);
+
+    while (restantes > 0) {
+        ssize_t escritos = writev(fd, actual, restantes);
+        if (escritos == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            desbloquearSigpipe(&sigpipe, errno == EPIPE);
+            return 0;
+        }
+
+        /* Avanzar sobre lo ya escrito */
+        while (restantes > 0 && (size_t)escritos >= actual->iov_len) {
+            escritos -= (ssize_t)actual->iov_len;
+            actual++;
+            restantes--;
+        }
+        if (restantes > 0) {
+            actual->iov_base = (char*)actual->iov_base + escritos;
+            actual->iov_len -= (size_t)escritos;
+        }
+    }
+
+    desbloquearSigpipe(&sigpipe, 0);
+    return 1;
+}
+
+/**
+ * @brief Envía un mensaje como trama, comprimiéndolo si supera el umbral
+ *
+ * Debe llamarse con mutexEnvio tomado (bufferEnvio es compartido).
+ */
+static Estado_t enviarTrama(ProcesoPar_t *pp, const char *mensaje, int longitud) {
+    CabeceraTrama_t cabecera;
+    const char *carga = mensaje;
+
+    cabecera.longitud = (uint32_t)longitud;
+    cabecera.longitudOriginal = (uint32_t)longitud;
+
+    if (longitud >= pp->umbralCompresion) {
+        size_t capacidad = PPLZ_CAPACIDAD_MAXIMA((size_t)longitud);
+        if (asegurarCapacidad(&pp->bufferEnvio, &pp->capacidadEnvio, capacidad)) {
+            int longitudComprimida = 0;
+            unsigned long long t0 = tiempoNs();
+            /* Solo compensa si ocupa menos: limitar el destino a longitud - 1 */
+            Estado_t estado = comprimirPPLZ(mensaje, longitud, pp->bufferEnvio,
+                                            longitud - 1, &longitudComprimida);
+            PP_SUMAR(pp->estadisticasCompresion.nsCompresion, tiempoNs() - t0);
+
+            if (estado == E_OK) {
+                cabecera.longitud = (uint32_t)longitudComprimida;
+                carga = pp->bufferEnvio;
+            }
+        }
+    }
+
+    if (!escribirTrama(pp->pipeSalida[1], &cabecera, carga)) {
+        return E_ENVIO_FALLO;
+    }
+
+    if (carga != mensaje) {
+        PP_SUMAR(pp->estadisticasCompresion.mensajesComprimidos, 1);
+        PP_SUMAR(pp->estadisticasCompresion.bytesOriginalesEnviados, longitud);
+        PP_SUMAR(pp->estadisticasCompresion.bytesComprimidosEnviados, cabecera.longitud);
+    } else {
+        PP_SUMAR(pp->estadisticasCompresion.mensajesSinComprimir, 1);
+    }
+
+    return E_OK;
+}
+
+Estado_t reescribirMensajeProcesoPar(ProcesoPar_t *pp, const char *mensaje, int longitud) {
+    if (pp->compresion) {
+        return enviarTrama(pp, mensaje, longitud);
+    }
+
+    /* Al reenviar no hay nadie que reintente: escribir el mensaje entero */
+    SigpipeBloqueado_t sigpipe;
+    bloquearSigpipe(&sigpipe);
+    while (longitud > 0) {
+        ssize_t escritos = write(pp->pipeSalida[1], mensaje, (size_t)longitud);
+        if (escritos == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            desbloquearSigpipe(&sigpipe, errno == EPIPE);
+            return E_ENVIO_FALLO;
+        }
+        mensaje += escritos;
+        longitud -= (int)escritos;
+    }
+    desbloquearSigpipe(&sigpipe, 0);
+    return E_OK;
+}
 #endif
 
 /**
@@ -61,10 +208,63 @@ Estado_t enviarMensajeProcesoPar(
     
     ssize_t bytesEscritos;
 
+    PP_TRAZA(ENVIO_INICIO, procesoPar->pid, longitud);
+
+    /* En modo duradero, anotado antes de escribirlo, y ambos con mutexEnvio:
+     * las secuencias siguen el orden de la tubería, así que confirmar en
+     * orden nunca da por recibido un mensaje que otro hilo aún no escribió.
+     * La captura, como en los demás caminos, solo anota lo ya escrito y con
+     * el mismo cerrojo, en el orden de la tubería */
+    if (__atomic_load_n(&procesoPar->diario, __ATOMIC_RELAXED) != NULL) {
+        pthread_mutex_lock(&procesoPar->mutexEnvio);
+        Estado_t estado = anotarDiario(procesoPar, mensaje, longitud);
+        if (estado == E_OK) {
+            estado = reescribirMensajeProcesoPar(procesoPar, mensaje, longitud);
+        } else {
+            estado = E_ENVIO_FALLO;
+        }
+        if (estado == E_OK) {
+            PP_CAPTURAR(procesoPar, PROCESOPAR_CAPTURA_ENVIO, mensaje, longitud);
+        }
+        pthread_mutex_unlock(&procesoPar->mutexEnvio);
+        PP_TRAZA(ENVIO_FIN, procesoPar->pid, estado);
+        return estado;
+    }
+
+    /* Con compresión negociada, todo mensaje viaja como trama */
+    if (procesoPar->compresion) {
+        pthread_mutex_lock(&procesoPar->mutexEnvio);
+        Estado_t estado = enviarTrama(procesoPar, mensaje, longitud);
+        if (estado == E_OK) {
+            PP_CAPTURAR(procesoPar, PROCESOPAR_CAPTURA_ENVIO, mensaje, longitud);
+        }
+        pthread_mutex_unlock(&procesoPar->mutexEnvio);
+        PP_TRAZA(ENVIO_FIN, procesoPar->pid, estado);
+        return estado;
+    }
+
+    /* Sin captura no hay cerrojo; con ella, mutexEnvio ordena la escritura
+     * y la anotación como en los otros caminos */
+    int capturando = __atomic_load_n(&procesoPar->captura, __ATOMIC_RELAXED) != NULL;
+    if (capturando) {
+        pthread_mutex_lock(&procesoPar->mutexEnvio);
+    }
+
     /* Escribir en la tubería de salida
      * pipeSalida[1] es el extremo de escritura que usa el padre
      */
+    SigpipeBloqueado_t sigpipe;
+    bloquearSigpipe(&sigpipe);
     bytesEscritos = write(procesoPar->pipeSalida[1], mensaje, longitud);
+    desbloquearSigpipe(&sigpipe, bytesEscritos == -1 && errno == EPIPE);
+    PP_TRAZA(ENVIO_FIN, procesoPar->pid, bytesEscritos);
+
+    if (capturando) {
+        if (bytesEscritos == longitud) {
+            PP_CAPTURAR(procesoPar, PROCESOPAR_CAPTURA_ENVIO, mensaje, longitud);
+        }
+        pthread_mutex_unlock(&procesoPar->mutexEnvio);
+    }
 
     if (bytesEscritos == -1 || bytesEscritos != longitud) {
         return E_ENVIO_FALLO;
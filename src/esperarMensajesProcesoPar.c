@@ -0,0 +1,93 @@
+/**
+ * @file esperarMensajesProcesoPar.c
+ * @brief Implementación de la espera con giro y bloqueo en modo de sondeo
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <poll.h>
+    #include <errno.h>
+#endif
+
+/**
+ * @brief Espera a que haya algún mensaje listo para recibirMensajesProcesoPar()
+ */
+Estado_t esperarMensajesProcesoPar(ProcesoPar_t *procesoPar, int usGiro, int msEspera) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || usGiro < 0) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    (void)msEspera;
+    return E_NO_SOPORTADO;
+#else
+    Estado_t estado = activarModoSondeo(procesoPar);
+    if (estado != E_OK) {
+        return estado;
+    }
+
+    /* Lo ya leído puede contener mensajes completos */
+    if (hayMensajeCompleto(procesoPar)) {
+        return E_OK;
+    }
+    if (procesoPar->finEntrada) {
+        return E_PROCESO_INACT;
+    }
+
+    /* Fase de giro: lecturas no bloqueantes hasta agotar el presupuesto */
+    if (usGiro > 0) {
+        unsigned long long limite = tiempoNs() + (unsigned long long)usGiro * 1000ULL;
+        do {
+            if (leerEntradaNoBloqueante(procesoPar) != 0) {
+                if (hayMensajeCompleto(procesoPar)) {
+                    return E_OK;
+                }
+                if (procesoPar->finEntrada) {
+                    return E_PROCESO_INACT;
+                }
+            }
+        } while (tiempoNs() < limite);
+    }
+
+    /* Fase de bloqueo: poll hasta que llegue un mensaje completo */
+    unsigned long long limite = (msEspera >= 0)
+        ? tiempoNs() + (unsigned long long)msEspera * 1000000ULL
+        : 0;
+
+    for (;;) {
+        int restante = -1;
+        if (msEspera >= 0) {
+            unsigned long long ahora = tiempoNs();
+            restante = (ahora >= limite) ? 0 : (int)((limite - ahora + 999999ULL) / 1000000ULL);
+        }
+
+        struct pollfd pfd = { procesoPar->pipeEntrada[0], POLLIN, 0 };
+        int listo = poll(&pfd, 1, restante);
+        if (listo == -1 && errno != EINTR) {
+            return E_PROCESO_INACT;
+        }
+
+        if (listo > 0) {
+            leerEntradaNoBloqueante(procesoPar);
+            if (hayMensajeCompleto(procesoPar)) {
+                return E_OK;
+            }
+            if (procesoPar->finEntrada) {
+                return E_PROCESO_INACT;
+            }
+        }
+
+        /* Trama incompleta o sin datos: seguir mientras quede tiempo */
+        if (msEspera >= 0 && tiempoNs() >= limite) {
+            return E_TIEMPO;
+        }
+    }
+#endif
+}
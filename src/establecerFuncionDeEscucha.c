@@ -3,13 +3,18 @@
  * @brief Implementación de la función para establecer un callback de escucha
  */
 
-#include "../include/ProcesoPar.h"
+#ifndef _WIN32
+    #define _GNU_SOURCE   /* pthread_attr_setaffinity_np */
+#endif
+
+#include "ProcesoParInterno.h"
 #include <stdlib.h>
 
 #ifdef _WIN32
     #include <windows.h>
 #else
     #include <pthread.h>
+    #include <sched.h>
     #include <unistd.h>
 #endif
 
@@ -17,23 +22,32 @@
 #ifdef _WIN32
 DWORD WINAPI hiloEscucha(LPVOID param) {
     ProcesoPar_t *pp = (ProcesoPar_t*)param;
-    char buffer[4096];
     DWORD bytesLeidos;
+    size_t disponible;
+    const char *mensaje;
+    int longitud;
 
     while (pp->activo && pp->funcionEscucha != NULL) {
+        char *buffer = reservarEntrada(pp, PP_TAMANO_LECTURA - 1, &disponible);
+        if (buffer == NULL) {
+            break;
+        }
+
         /* Leer de la tubería de entrada */
         BOOL resultado = ReadFile(
             pp->hTuberiaEntrada,
             buffer,
-            sizeof(buffer) - 1,
+            (DWORD)disponible,
             &bytesLeidos,
             NULL
         );
 
         if (resultado && bytesLeidos > 0) {
-            buffer[bytesLeidos] = '\0';  /* Terminar la cadena */
+            pp->longitudEntrada += bytesLeidos;
             /* Llamar a la función de escucha del usuario */
-            pp->funcionEscucha(buffer, bytesLeidos);
+            while (extraerMensaje(pp, (size_t)-1, &mensaje, &longitud) > 0) {
+                pp->funcionEscucha(mensaje, longitud);
+            }
         } else {
             /* Error o fin de archivo */
             break;
@@ -45,19 +59,42 @@ DWORD WINAPI hiloEscucha(LPVOID param) {
 #else
 void* hiloEscucha(void* param) {
     ProcesoPar_t *pp = (ProcesoPar_t*)param;
-    char buffer[4096];
     ssize_t bytesLeidos;
+    size_t disponible;
+    const char *mensaje;
+    int longitud;
+    int resultado;
+
+    /* Entregar primero lo que quedó leído durante la negociación */
+    while (extraerMensaje(pp, (size_t)-1, &mensaje, &longitud) > 0) {
+        despacharMensaje(pp, mensaje, longitud);
+    }
+
+    /* Sin función de escucha el hilo sigue vivo para las respuestas de llamarProcesoPar().
+     * Al relanzar, lee las respuestas a lo reenviado antes de que activo vuelva a 1 */
+    while (__atomic_load_n(&pp->reenviandoDiario, __ATOMIC_ACQUIRE) || pp->activo) {
+        /* Con tramas o delimitador se lee en bloques mayores */
+        char *buffer = reservarEntrada(pp, tamanoLectura(pp), &disponible);
+        if (buffer == NULL) {
+            break;
+        }
 
-    while (pp->activo && pp->funcionEscucha != NULL) {
         /* Leer de la tubería de entrada
          * pipeEntrada[0] es el extremo de lectura que usa el padre
          */
-        bytesLeidos = read(pp->pipeEntrada[0], buffer, sizeof(buffer) - 1);
+        bytesLeidos = read(pp->pipeEntrada[0], buffer, disponible);
 
         if (bytesLeidos > 0) {
-            buffer[bytesLeidos] = '\0';  /* Terminar la cadena */
-            /* Llamar a la función de escucha del usuario */
-            pp->funcionEscucha(buffer, bytesLeidos);
+            PP_TRAZA(LECTURA, pp->pid, bytesLeidos);
+            pp->longitudEntrada += (size_t)bytesLeidos;
+            /* Entregar cada mensaje completo a su llamada o a la función de escucha */
+            while ((resultado = extraerMensaje(pp, (size_t)-1, &mensaje, &longitud)) > 0) {
+                despacharMensaje(pp, mensaje, longitud);
+            }
+            if (resultado < 0) {
+                /* Trama inválida: el flujo ya no es recuperable */
+                break;
+            }
         } else if (bytesLeidos == 0) {
             /* Fin de archivo - el hijo cerró su extremo */
             break;
@@ -67,8 +104,47 @@ void* hiloEscucha(void* param) {
         }
     }
 
+    /* Nadie más va a responder a las llamadas en espera */
+    fallarLlamadasPendientes(pp);
+
     return NULL;
 }
+
+/**
+ * @brief Crea el hilo de escucha aunque no haya función de escucha
+ */
+Estado_t crearHiloEscucha(ProcesoPar_t *pp) {
+    /* Fijar el hilo a sus CPUs desde el primer instante, si se pidió al lanzar */
+    pthread_attr_t atributos;
+    pthread_attr_init(&atributos);
+
+    if (pp->cpusEscucha != NULL) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int i = 0; i < pp->numCpusEscucha; i++) {
+            CPU_SET(pp->cpusEscucha[i], &cpus);
+        }
+        pthread_attr_setaffinity_np(&atributos, sizeof(cpus), &cpus);
+    }
+
+    /* Crear un hilo que escuche mensajes del proceso hijo */
+    int resultado = pthread_create(
+        &pp->hiloEscucha,  /* ID del hilo */
+        &atributos,        /* Afinidad (si la hay) */
+        hiloEscucha,       /* Función del hilo */
+        pp                 /* Parámetro para la función */
+    );
+    pthread_attr_destroy(&atributos);
+
+    if (resultado != 0) {
+        return E_CREAR_HILO;
+    }
+
+    /* El hilo usa los buffers del proceso par: destruirProcesoPar lo espera
+     * con pthread_join antes de liberarlos */
+    pp->hiloCreado = 1;
+    return E_OK;
+}
 #endif
 
 /**
@@ -88,6 +164,13 @@ Estado_t establecerFuncionDeEscucha(
         return E_PROCESO_INACT;
     }
 
+#ifndef _WIN32
+    /* El modo de sondeo y el hilo de escucha leen de la misma tubería */
+    if (procesoPar->modoSondeo) {
+        return E_MODO;
+    }
+#endif
+
     /* Guardar la función de escucha */
     procesoPar->funcionEscucha = f;
 
@@ -114,21 +197,15 @@ Estado_t establecerFuncionDeEscucha(
     /* ========================================
      * IMPLEMENTACIÓN PARA LINUX
      * ======================================== */
-    
-    /* Crear un hilo que escuche mensajes del proceso hijo */
-    int resultado = pthread_create(
-        &procesoPar->hiloEscucha,  /* ID del hilo */
-        NULL,                       /* Atributos por defecto */
-        hiloEscucha,               /* Función del hilo */
-        procesoPar                 /* Parámetro para la función */
-    );
 
-    if (resultado != 0) {
-        return E_CREAR_HILO;
-    }
+    /* llamarProcesoPar() pudo crear ya el hilo: basta con la nueva función */
+    pthread_mutex_lock(&procesoPar->mutexOrden);
+    Estado_t estado = procesoPar->hiloCreado ? E_OK : crearHiloEscucha(procesoPar);
+    pthread_mutex_unlock(&procesoPar->mutexOrden);
 
-    /* Hacer el hilo "detached" para que se limpie automáticamente */
-    pthread_detach(procesoPar->hiloEscucha);
+    if (estado != E_OK) {
+        return estado;
+    }
 
 #endif
 
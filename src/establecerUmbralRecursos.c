@@ -0,0 +1,42 @@
+/**
+ * @file establecerUmbralRecursos.c
+ * @brief Implementación de los umbrales de recursos con función de aviso
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Establece un umbral de recurso con su función de aviso
+ */
+Estado_t establecerUmbralRecursos(
+    ProcesoPar_t *procesoPar,
+    int recurso,
+    unsigned long long limite,
+    FuncionUmbral_t f
+) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || recurso < 0 || recurso >= PROCESOPAR_NUM_RECURSOS) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    (void)limite;
+    (void)f;
+    return E_NO_SOPORTADO;
+#else
+    pthread_mutex_lock(&muestreador.mutex);
+
+    MuestreoRecursos_t *m = procesoPar->muestreo;
+    if (m == NULL) {
+        pthread_mutex_unlock(&muestreador.mutex);
+        return E_PAR_INC;
+    }
+
+    m->umbrales[recurso].limite = limite;
+    m->umbrales[recurso].funcion = f;
+    m->umbrales[recurso].superado = 0;
+
+    pthread_mutex_unlock(&muestreador.mutex);
+    return E_OK;
+#endif
+}
@@ -0,0 +1,32 @@
+/**
+ * @file inicializarOpcionesProcesoPar.c
+ * @brief Implementación de la inicialización de opciones de lanzamiento
+ */
+
+#include "ProcesoParInterno.h"
+#include <string.h>
+
+/**
+ * @brief Inicializa unas opciones de lanzamiento con los valores por defecto
+ */
+Estado_t inicializarOpcionesProcesoPar(OpcionesProcesoPar_t *opciones) {
+    /* Validar parámetro */
+    if (opciones == NULL) {
+        return E_PAR_INC;
+    }
+
+    memset(opciones, 0, sizeof(*opciones));
+    opciones->compresion = 0;
+    opciones->umbralCompresion = PROCESOPAR_UMBRAL_COMPRESION;
+    opciones->msNegociacion = PROCESOPAR_MS_NEGOCIACION;
+    opciones->cpusHijo = NULL;
+    opciones->cpusEscucha = NULL;
+    opciones->nodoNuma = -1;
+    opciones->nice = PROCESOPAR_SIN_CAMBIO;
+    opciones->politica = -1;
+    opciones->prioridad = 0;
+    opciones->cgroup = NULL;
+    opciones->delimitador = -1;
+
+    return E_OK;
+}
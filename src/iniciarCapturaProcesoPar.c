@@ -0,0 +1,80 @@
+/**
+ * @file iniciarCapturaProcesoPar.c
+ * @brief Implementación del inicio de la captura de tráfico de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Empieza a capturar el tráfico de un proceso par en un archivo
+ */
+Estado_t iniciarCapturaProcesoPar(ProcesoPar_t *procesoPar, const char *rutaArchivo, size_t bytesAnillo) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || rutaArchivo == NULL) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    (void)bytesAnillo;
+    return E_NO_SOPORTADO;
+#else
+    if (procesoPar->captura != NULL) {
+        return E_MODO;
+    }
+
+    /* Potencia de dos, con sitio al menos para un registro pequeño */
+    if (bytesAnillo == 0) {
+        bytesAnillo = PROCESOPAR_CAPTURA_BYTES;
+    }
+    size_t capacidad = 4096;
+    while (capacidad < bytesAnillo) {
+        capacidad *= 2;
+    }
+
+    CapturaProcesoPar_t *c = (CapturaProcesoPar_t*)calloc(1, sizeof(CapturaProcesoPar_t));
+    if (c == NULL) {
+        return E_NO_MEMORIA;
+    }
+    c->anillo = (char*)calloc(1, capacidad);
+    if (c->anillo == NULL) {
+        free(c);
+        return E_NO_MEMORIA;
+    }
+    c->capacidad = capacidad;
+
+    c->fd = open(rutaArchivo, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (c->fd == -1) {
+        free(c->anillo);
+        free(c);
+        return E_PAR_INC;
+    }
+
+    CabeceraCaptura_t cabecera;
+    memset(&cabecera, 0, sizeof(cabecera));
+    memcpy(cabecera.magia, PROCESOPAR_MAGIA_CAPTURA, sizeof(cabecera.magia));
+    cabecera.version = PROCESOPAR_VERSION_CAPTURA;
+    if (write(c->fd, &cabecera, sizeof(cabecera)) != (ssize_t)sizeof(cabecera) ||
+        pthread_create(&c->hilo, NULL, hiloVolcadoCaptura, c) != 0) {
+        close(c->fd);
+        free(c->anillo);
+        free(c);
+        return E_CREAR_HILO;
+    }
+
+    __atomic_store_n(&procesoPar->captura, c, __ATOMIC_RELEASE);
+    return E_OK;
+#endif
+}
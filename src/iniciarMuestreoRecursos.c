@@ -0,0 +1,63 @@
+/**
+ * @file iniciarMuestreoRecursos.c
+ * @brief Implementación del arranque del hilo muestreador de recursos
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <time.h>
+#endif
+
+/**
+ * @brief Arranca el hilo muestreador de recursos (o cambia su intervalo)
+ */
+Estado_t iniciarMuestreoRecursos(int msIntervalo) {
+    /* Validar parámetro */
+    if (msIntervalo <= 0) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    pthread_mutex_lock(&muestreador.mutex);
+
+    /* Parada en curso: esperar al join antes de arrancar otro hilo */
+    while (muestreador.activo && muestreador.detener) {
+        pthread_cond_wait(&muestreador.condicion, &muestreador.mutex);
+    }
+
+    /* Ya en marcha: el nuevo intervalo se aplica a partir del siguiente periodo */
+    if (muestreador.activo) {
+        muestreador.msIntervalo = msIntervalo;
+        pthread_mutex_unlock(&muestreador.mutex);
+        return E_OK;
+    }
+
+    /* La condición espera con el reloj monotónico, como tiempoNs(); se
+     * prepara una sola vez porque otras llamadas pueden estar esperando en ella */
+    if (!muestreador.condicionLista) {
+        pthread_condattr_t atributos;
+        pthread_condattr_init(&atributos);
+        pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+        pthread_cond_destroy(&muestreador.condicion);
+        pthread_cond_init(&muestreador.condicion, &atributos);
+        pthread_condattr_destroy(&atributos);
+        muestreador.condicionLista = 1;
+    }
+
+    muestreador.msIntervalo = msIntervalo;
+    muestreador.detener = 0;
+
+    if (pthread_create(&muestreador.hilo, NULL, hiloMuestreador, NULL) != 0) {
+        pthread_mutex_unlock(&muestreador.mutex);
+        return E_CREAR_HILO;
+    }
+
+    muestreador.activo = 1;
+    pthread_mutex_unlock(&muestreador.mutex);
+    return E_OK;
+#endif
+}
@@ -0,0 +1,271 @@
+/**
+ * @file lanzarLoteProcesoPar.c
+ * @brief Implementación del lanzamiento concurrente de muchos procesos pares
+ */
+
+#ifndef _WIN32
+    #define _GNU_SOURCE   /* O_PATH */
+#endif
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <limits.h>
+    #include <pthread.h>
+#endif
+
+/* Hilos lanzadores por defecto: fork() escala poco más allá de unos pocos */
+#define PP_HILOS_LOTE_DEFECTO 4
+
+void liberarProcesoPar(ProcesoPar_t *pp) {
+    BloqueProcesoPar_t *bloque = pp->bloque;
+
+    if (bloque == NULL) {
+        free(pp);
+    } else if (__atomic_sub_fetch(&bloque->referencias, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(bloque);
+    }
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Ejecutable resuelto una vez para todo el lote
+ */
+typedef struct EjecutableResuelto {
+    const char *nombre;   /* Nombre tal como viene en la especificación */
+    int fd;               /* Descriptor O_PATH, o -1 si no se pudo resolver */
+} EjecutableResuelto_t;
+
+/**
+ * @brief Estado compartido por los hilos lanzadores
+ */
+typedef struct TrabajoLote {
+    EspecificacionProcesoPar_t *especificaciones;
+    int numero;
+    int siguiente;                      /* Próximo índice a lanzar (atómico) */
+    char *pares;                        /* Primera estructura del bloque */
+    size_t paso;                        /* Distancia entre estructuras */
+    const int *fdEjecutables;           /* fd resuelto de cada especificación */
+} TrabajoLote_t;
+
+/**
+ * @brief Busca el ejecutable como lo haría execvp y abre un descriptor O_PATH
+ */
+static int abrirEjecutable(const char *nombre) {
+    if (strchr(nombre, '/') != NULL) {
+        return open(nombre, O_PATH | O_CLOEXEC);
+    }
+
+    const char *ruta = getenv("PATH");
+    if (ruta == NULL) {
+        ruta = "/bin:/usr/bin";
+    }
+
+    char candidato[PATH_MAX];
+    while (*ruta != '\0') {
+        const char *fin = strchr(ruta, ':');
+        size_t longitud = (fin != NULL) ? (size_t)(fin - ruta) : strlen(ruta);
+
+        /* Un elemento vacío de PATH es el directorio actual */
+        int n = (longitud == 0)
+            ? snprintf(candidato, sizeof(candidato), "./%s", nombre)
+            : snprintf(candidato, sizeof(candidato), "%.*s/%s", (int)longitud, ruta, nombre);
+
+        if (n > 0 && (size_t)n < sizeof(candidato) && access(candidato, X_OK) == 0) {
+            return open(candidato, O_PATH | O_CLOEXEC);
+        }
+
+        if (fin == NULL) {
+            break;
+        }
+        ruta = fin + 1;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Hilo lanzador: toma especificaciones hasta agotarlas
+ */
+static void *hiloLanzador(void *param) {
+    TrabajoLote_t *trabajo = (TrabajoLote_t*)param;
+    OpcionesProcesoPar_t porDefecto;
+    inicializarOpcionesProcesoPar(&porDefecto);
+
+    for (;;) {
+        int i = __atomic_fetch_add(&trabajo->siguiente, 1, __ATOMIC_RELAXED);
+        if (i >= trabajo->numero) {
+            break;
+        }
+
+        EspecificacionProcesoPar_t *e = &trabajo->especificaciones[i];
+        ProcesoPar_t *pp = (ProcesoPar_t*)(trabajo->pares + (size_t)i * trabajo->paso);
+        const OpcionesProcesoPar_t *opciones = (e->opciones != NULL) ? e->opciones : &porDefecto;
+
+        /* Un ejecutable que no se pudo resolver tampoco lo encontraría execvp */
+        if (trabajo->fdEjecutables[i] < 0) {
+            e->estado = E_CREAR_PROCESO;
+        } else {
+            e->estado = iniciarProcesoPar(pp, e->nombreArchivoEjecutable, e->listaLineaComando,
+                                          opciones, trabajo->fdEjecutables[i]);
+        }
+        e->procesoPar = (e->estado == E_OK) ? pp : NULL;
+    }
+
+    return NULL;
+}
+
+#endif
+
+/**
+ * @brief Lanza muchos procesos pares a la vez
+ */
+Estado_t lanzarLoteProcesoPar(
+    EspecificacionProcesoPar_t *especificaciones,
+    int numero,
+    int numHilos,
+    unsigned long long *nsTotales
+) {
+    /* Validar parámetros */
+    if (especificaciones == NULL || numero <= 0) {
+        return E_PAR_INC;
+    }
+    for (int i = 0; i < numero; i++) {
+        const OpcionesProcesoPar_t *o = especificaciones[i].opciones;
+        if (especificaciones[i].nombreArchivoEjecutable == NULL ||
+            (o != NULL && (o->umbralCompresion < 0 || o->msNegociacion < 0 ||
+                           o->delimitador < -1 || o->delimitador > 255))) {
+            return E_PAR_INC;
+        }
+        especificaciones[i].procesoPar = NULL;
+        especificaciones[i].estado = E_CREAR_PROCESO;
+    }
+
+    unsigned long long inicio = tiempoNs();
+
+#ifdef _WIN32
+    /* ========================================
+     * IMPLEMENTACIÓN PARA WINDOWS
+     * ======================================== */
+
+    /* CreateProcess no tiene equivalente a execveat: lanzar en secuencia */
+    (void)numHilos;
+    for (int i = 0; i < numero; i++) {
+        EspecificacionProcesoPar_t *e = &especificaciones[i];
+        e->estado = lanzarProcesoParConOpciones(e->nombreArchivoEjecutable,
+                                                e->listaLineaComando, e->opciones,
+                                                &e->procesoPar);
+    }
+
+#else
+    /* ========================================
+     * IMPLEMENTACIÓN PARA LINUX
+     * ======================================== */
+
+    /* Reservar todas las estructuras en un bloque contiguo */
+    size_t paso = (sizeof(ProcesoPar_t) + PP_LINEA_CACHE - 1) / PP_LINEA_CACHE * PP_LINEA_CACHE;
+    size_t tamano = PP_LINEA_CACHE + paso * (size_t)numero;
+    BloqueProcesoPar_t *bloque = (BloqueProcesoPar_t*)aligned_alloc(PP_LINEA_CACHE, tamano);
+    int *fdEjecutables = (int*)malloc((size_t)numero * sizeof(int));
+    EjecutableResuelto_t *resueltos = (EjecutableResuelto_t*)malloc((size_t)numero * sizeof(EjecutableResuelto_t));
+
+    if (bloque == NULL || fdEjecutables == NULL || resueltos == NULL) {
+        free(bloque);
+        free(fdEjecutables);
+        free(resueltos);
+        return E_NO_MEMORIA;
+    }
+    memset(bloque, 0, tamano);
+
+    char *pares = (char*)bloque + PP_LINEA_CACHE;
+    for (int i = 0; i < numero; i++) {
+        ((ProcesoPar_t*)(pares + (size_t)i * paso))->bloque = bloque;
+    }
+    bloque->referencias = numero;
+
+    /* Resolver cada ejecutable distinto una sola vez */
+    int numResueltos = 0;
+    for (int i = 0; i < numero; i++) {
+        const char *nombre = especificaciones[i].nombreArchivoEjecutable;
+        int j = 0;
+        while (j < numResueltos && strcmp(resueltos[j].nombre, nombre) != 0) {
+            j++;
+        }
+        if (j == numResueltos) {
+            resueltos[j].nombre = nombre;
+            resueltos[j].fd = abrirEjecutable(nombre);
+            numResueltos++;
+        }
+        fdEjecutables[i] = resueltos[j].fd;
+    }
+
+    /* Repartir los lanzamientos entre los hilos */
+    TrabajoLote_t trabajo;
+    trabajo.especificaciones = especificaciones;
+    trabajo.numero = numero;
+    trabajo.siguiente = 0;
+    trabajo.pares = pares;
+    trabajo.paso = paso;
+    trabajo.fdEjecutables = fdEjecutables;
+
+    if (numHilos <= 0) {
+        numHilos = PP_HILOS_LOTE_DEFECTO;
+    }
+    if (numHilos > numero) {
+        numHilos = numero;
+    }
+
+    pthread_t *hilos = (pthread_t*)malloc((size_t)numHilos * sizeof(pthread_t));
+    int hilosCreados = 0;
+    if (hilos != NULL) {
+        while (hilosCreados < numHilos &&
+               pthread_create(&hilos[hilosCreados], NULL, hiloLanzador, &trabajo) == 0) {
+            hilosCreados++;
+        }
+    }
+
+    /* Si no se pudo crear ningún hilo, lanzar desde este mismo */
+    if (hilosCreados == 0) {
+        hiloLanzador(&trabajo);
+    }
+    for (int i = 0; i < hilosCreados; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    free(hilos);
+
+    for (int i = 0; i < numResueltos; i++) {
+        if (resueltos[i].fd >= 0) {
+            close(resueltos[i].fd);
+        }
+    }
+    free(resueltos);
+    free(fdEjecutables);
+
+    /* Devolver al bloque las referencias de los lanzamientos fallidos */
+    for (int i = 0; i < numero; i++) {
+        if (especificaciones[i].estado != E_OK) {
+            liberarProcesoPar((ProcesoPar_t*)(pares + (size_t)i * paso));
+        }
+    }
+
+#endif
+
+    if (nsTotales != NULL) {
+        *nsTotales = tiempoNs() - inicio;
+    }
+
+    for (int i = 0; i < numero; i++) {
+        if (especificaciones[i].estado != E_OK) {
+            return especificaciones[i].estado;
+        }
+    }
+    return E_OK;
+}
@@ -0,0 +1,903 @@
+/**
+ * @file lanzarProcesoParConOpciones.c
+ * @brief Implementación de la función para crear un proceso par con opciones
+ */
+
+#ifndef _WIN32
+    #define _GNU_SOURCE   /* execvpe, cpu_set_t */
+#endif
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+    /* Implementación para Windows */
+    #include <windows.h>
+#else
+    /* Implementación para Linux */
+    #include <unistd.h>
+    #include <sys/types.h>
+    #include <sys/wait.h>
+    #include <signal.h>
+    #include <pthread.h>
+    #include <poll.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/syscall.h>
+    #include <sys/resource.h>
+    #include <sched.h>
+
+    extern char **environ;
+#endif
+
+#ifndef _WIN32
+/**
+ * @brief Construye el entorno del hijo: el del padre más la oferta de compresión
+ *
+ * Se prepara antes de fork() para que el hijo no tenga que reservar memoria.
+ */
+static char **construirEntornoHijo(void) {
+    size_t n = 0;
+    while (environ[n] != NULL) {
+        n++;
+    }
+
+    char **entorno = (char**)malloc((n + 2) * sizeof(char*));
+    if (entorno == NULL) {
+        return NULL;
+    }
+
+    size_t j = 0;
+    for (size_t i = 0; i < n; i++) {
+        /* Sustituir una oferta heredada del propio padre */
+        if (strncmp(environ[i], PROCESOPAR_VARIABLE_COMPRESION "=",
+                    sizeof(PROCESOPAR_VARIABLE_COMPRESION)) != 0) {
+            entorno[j++] = environ[i];
+        }
+    }
+    entorno[j++] = (char*)(PROCESOPAR_VARIABLE_COMPRESION "=" PROCESOPAR_CODEC_COMPRESION);
+    entorno[j] = NULL;
+    return entorno;
+}
+
+/**
+ * @brief Espera el saludo con el que el hijo acepta la compresión y lo confirma
+ *
+ * Los bytes leídos que no formen el saludo se quedan en bufferEntrada para
+ * que el hilo de escucha los entregue como primer mensaje. El hijo no pasa
+ * a tramas hasta leer la aceptación: si el saludo llega tarde, ambos lados
+ * siguen sin tramas. Usa las tuberías indicadas, que relanzarProcesoPar()
+ * aún no ha puesto en pp.
+ *
+ * @return 1 si el hijo aceptó la compresión, 0 si no
+ */
+static int negociarCompresion(ProcesoPar_t *pp, int fdEntrada, int fdSalida, int msNegociacion) {
+    const char *saludo = PROCESOPAR_SALUDO_COMPRESION;
+    size_t longitudSaludo = strlen(saludo);
+    unsigned long long limite = tiempoNs() + (unsigned long long)msNegociacion * 1000000ULL;
+
+    while (pp->longitudEntrada < longitudSaludo) {
+        /* Sin saludo a tiempo, el hijo sigue sin tramas; si el saludo
+         * llega después, la entrada lo descarta */
+        unsigned long long ahora = tiempoNs();
+        if (ahora >= limite) {
+            pp->saludoTardio = 1;
+            return 0;
+        }
+
+        struct pollfd pfd = { fdEntrada, POLLIN, 0 };
+        int listo = poll(&pfd, 1, (int)((limite - ahora + 999999ULL) / 1000000ULL));
+        if (listo == -1 && errno == EINTR) {
+            continue;
+        }
+        if (listo == 0) {
+            pp->saludoTardio = 1;
+            return 0;
+        }
+        if (listo < 0) {
+            return 0;
+        }
+
+        size_t disponible;
+        char *destino = reservarEntrada(pp, longitudSaludo, &disponible);
+        if (destino == NULL) {
+            return 0;
+        }
+
+        /* Leer solo hasta completar el saludo, sin consumir mensajes posteriores */
+        ssize_t leidos = read(fdEntrada, destino, longitudSaludo - pp->longitudEntrada);
+        if (leidos <= 0) {
+            return 0;
+        }
+        pp->longitudEntrada += (size_t)leidos;
+
+        if (memcmp(pp->bufferEntrada, saludo, pp->longitudEntrada) != 0) {
+            return 0;
+        }
+    }
+
+    /* Saludo completo: descartarlo */
+    pp->inicioEntrada = 0;
+    pp->longitudEntrada = 0;
+
+    /* Lo primero que lee el hijo: desde aquí, todo en tramas */
+    const char *aceptacion = PROCESOPAR_ACEPTACION_COMPRESION;
+    size_t pendiente = strlen(aceptacion);
+    SigpipeBloqueado_t sigpipe;
+    bloquearSigpipe(&sigpipe);
+    while (pendiente > 0) {
+        ssize_t escritos = write(fdSalida, aceptacion, pendiente);
+        if (escritos == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            desbloquearSigpipe(&sigpipe, errno == EPIPE);
+            return 0;
+        }
+        aceptacion += escritos;
+        pendiente -= (size_t)escritos;
+    }
+    desbloquearSigpipe(&sigpipe, 0);
+    return 1;
+}
+
+/**
+ * @brief Ubicación y planificación que el hijo aplica sobre sí mismo antes de exec
+ *
+ * Todo se prepara en el padre para que el hijo solo haga llamadas al sistema.
+ */
+typedef struct UbicacionHijo {
+    int aplicar;          /* 1 si hay algo que aplicar en el hijo */
+    int hayCpus;          /* 1 si hay que fijar la afinidad */
+    cpu_set_t cpus;       /* CPUs permitidas para el hijo */
+    int nice;             /* PROCESOPAR_SIN_CAMBIO para no tocarlo */
+    int politica;         /* -1 para no tocarla */
+    int prioridad;        /* Prioridad de la política */
+    int fdCgroup;         /* cgroup.procs abierto para escritura, o -1 */
+} UbicacionHijo_t;
+
+/**
+ * @brief Añade a un conjunto las CPUs de una lista y las del nodo NUMA
+ * @return Número de CPUs añadidas, o -1 si algún identificador no es válido
+ */
+static int construirConjuntoCpus(const int *lista, int numero, int nodoNuma, cpu_set_t *cpus) {
+    int anadidas = 0;
+    CPU_ZERO(cpus);
+
+    if (lista != NULL) {
+        for (int i = 0; i < numero; i++) {
+            if (lista[i] < 0 || lista[i] >= CPU_SETSIZE) {
+                return -1;
+            }
+            CPU_SET(lista[i], cpus);
+            anadidas++;
+        }
+    }
+
+    if (nodoNuma >= 0) {
+        int cpusNodo[PP_MAX_CPUS];
+        int n = leerCpusNodo(nodoNuma, cpusNodo, PP_MAX_CPUS);
+        if (n <= 0) {
+            return -1;
+        }
+        for (int i = 0; i < n; i++) {
+            if (cpusNodo[i] < CPU_SETSIZE) {
+                CPU_SET(cpusNodo[i], cpus);
+                anadidas++;
+            }
+        }
+    }
+
+    return anadidas;
+}
+
+/**
+ * @brief Prepara la ubicación del hijo y guarda en pp la del hilo de escucha
+ *
+ * Con pp NULL (al relanzar) solo se prepara la del hijo: el hilo de
+ * escucha conserva la que ya tenía.
+ */
+static Estado_t prepararUbicacion(ProcesoPar_t *pp, const OpcionesProcesoPar_t *o, UbicacionHijo_t *u) {
+    memset(u, 0, sizeof(*u));
+    u->nice = o->nice;
+    u->politica = o->politica;
+    u->prioridad = o->prioridad;
+    u->fdCgroup = -1;
+
+    if (o->numCpusHijo < 0 || o->numCpusEscucha < 0 ||
+        (o->nice != PROCESOPAR_SIN_CAMBIO && (o->nice < -20 || o->nice > 19))) {
+        return E_PAR_INC;
+    }
+
+    /* CPUs del hijo */
+    int n = construirConjuntoCpus(o->cpusHijo, o->numCpusHijo, o->nodoNuma, &u->cpus);
+    if (n < 0) {
+        return E_PAR_INC;
+    }
+    u->hayCpus = (n > 0);
+
+    /* CPUs del hilo de escucha: se aplican en establecerFuncionDeEscucha */
+    cpu_set_t cpusEscucha;
+    n = construirConjuntoCpus(o->cpusEscucha, o->numCpusEscucha, o->nodoNuma, &cpusEscucha);
+    if (n < 0) {
+        return E_PAR_INC;
+    }
+    if (n > 0 && pp != NULL) {
+        pp->cpusEscucha = (int*)malloc((size_t)CPU_COUNT(&cpusEscucha) * sizeof(int));
+        if (pp->cpusEscucha == NULL) {
+            return E_NO_MEMORIA;
+        }
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &cpusEscucha)) {
+                pp->cpusEscucha[pp->numCpusEscucha++] = c;
+            }
+        }
+    }
+
+    /* cgroup: abrir ahora para que el hijo solo tenga que escribir su PID */
+    if (o->cgroup != NULL) {
+        char ruta[4096];
+        int longitud = snprintf(ruta, sizeof(ruta), "%s/cgroup.procs", o->cgroup);
+        if (longitud < 0 || (size_t)longitud >= sizeof(ruta)) {
+            return E_PAR_INC;
+        }
+        u->fdCgroup = open(ruta, O_WRONLY | O_CLOEXEC);
+        if (u->fdCgroup == -1) {
+            return E_UBICACION;
+        }
+    }
+
+    u->aplicar = u->hayCpus || u->nice != PROCESOPAR_SIN_CAMBIO ||
+                 u->politica >= 0 || u->fdCgroup != -1;
+    return E_OK;
+}
+
+/**
+ * @brief Libera lo reservado por prepararUbicacion() si el lanzamiento falla
+ */
+static void descartarUbicacion(ProcesoPar_t *pp, UbicacionHijo_t *u) {
+    if (u->fdCgroup != -1) {
+        close(u->fdCgroup);
+        u->fdCgroup = -1;
+    }
+    if (pp != NULL) {
+        free(pp->cpusEscucha);
+        pp->cpusEscucha = NULL;
+        pp->numCpusEscucha = 0;
+    }
+}
+
+/**
+ * @brief Aplica la ubicación en el proceso hijo (solo llamadas seguras tras fork)
+ * @return 0 si todo se aplicó, -1 en caso contrario
+ */
+static int aplicarUbicacion(const UbicacionHijo_t *u) {
+    /* Entrar en el cgroup primero para que el resto ya cuente en él */
+    if (u->fdCgroup != -1) {
+        char texto[16];
+        int i = (int)sizeof(texto);
+        pid_t pid = getpid();
+        do {
+            texto[--i] = (char)('0' + pid % 10);
+            pid /= 10;
+        } while (pid > 0);
+        if (write(u->fdCgroup, texto + i, sizeof(texto) - (size_t)i) == -1) {
+            return -1;
+        }
+    }
+
+    if (u->hayCpus && sched_setaffinity(0, sizeof(u->cpus), &u->cpus) == -1) {
+        return -1;
+    }
+
+    if (u->politica >= 0) {
+        struct sched_param parametro;
+        memset(&parametro, 0, sizeof(parametro));
+        parametro.sched_priority = u->prioridad;
+        if (sched_setscheduler(0, u->politica, &parametro) == -1) {
+            return -1;
+        }
+    }
+
+    if (u->nice != PROCESOPAR_SIN_CAMBIO && setpriority(PRIO_PROCESS, 0, u->nice) == -1) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Crea las tuberías y el hijo con la ubicación ya preparada
+ *
+ * Devuelve en entrada[0] y salida[1] los extremos del padre; los del hijo
+ * quedan cerrados. Si tiene éxito, u->fdCgroup queda cerrado; si no, quien
+ * llama libera la ubicación con descartarUbicacion().
+ */
+static Estado_t crearHijo(
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    int fdEjecutable,
+    UbicacionHijo_t *u,
+    int entrada[2],
+    int salida[2],
+    pid_t *pid
+) {
+    Estado_t estado = E_OK;
+
+    char **entornoHijo = NULL;
+    if (opciones->compresion) {
+        entornoHijo = construirEntornoHijo();
+        if (entornoHijo == NULL) {
+            return E_NO_MEMORIA;
+        }
+    }
+
+    /* Tubería de estado: el hijo escribe en ella si no puede aplicar la
+     * ubicación; si exec tiene éxito, O_CLOEXEC la cierra y el padre lee EOF */
+    int pipeEstado[2] = { -1, -1 };
+    if (u->aplicar && pipe2(pipeEstado, O_CLOEXEC) == -1) {
+        free(entornoHijo);
+        return E_CREAR_PIPE;
+    }
+
+    /* Crear tuberías
+     * entrada: el hijo ESCRIBE aquí, el padre LEE desde aquí
+     * salida: el padre ESCRIBE aquí, el hijo LEE desde aquí
+     *
+     * O_CLOEXEC: los extremos del padre no deben heredarlos otros hijos
+     * (lanzados después o en paralelo), o nunca verían EOF */
+    if (pipe2(entrada, O_CLOEXEC) == -1) {
+        estado = E_CREAR_PIPE;
+    } else if (pipe2(salida, O_CLOEXEC) == -1) {
+        close(entrada[0]);
+        close(entrada[1]);
+        estado = E_CREAR_PIPE;
+    }
+
+    if (estado != E_OK) {
+        if (pipeEstado[0] != -1) {
+            close(pipeEstado[0]);
+            close(pipeEstado[1]);
+        }
+        free(entornoHijo);
+        return estado;
+    }
+
+    /* Crear el proceso hijo con fork() */
+    pid_t hijo = fork();
+
+    if (hijo == -1) {
+        /* Error al crear proceso */
+        close(entrada[0]);
+        close(entrada[1]);
+        close(salida[0]);
+        close(salida[1]);
+        if (pipeEstado[0] != -1) {
+            close(pipeEstado[0]);
+            close(pipeEstado[1]);
+        }
+        free(entornoHijo);
+        return E_CREAR_PROCESO;
+    }
+
+    if (hijo == 0) {
+        /* ===== CÓDIGO DEL PROCESO HIJO ===== */
+
+        /* Cerrar extremos que el hijo no usa */
+        close(entrada[0]);  /* El hijo no lee de entrada */
+        close(salida[1]);   /* El hijo no escribe en salida */
+
+        /* Afinidad, planificación y cgroup antes de ejecutar el programa */
+        if (u->aplicar) {
+            close(pipeEstado[0]);
+            if (aplicarUbicacion(u) == -1) {
+                Estado_t fallo = E_UBICACION;
+                ssize_t ignorado = write(pipeEstado[1], &fallo, sizeof(fallo));
+                (void)ignorado;
+                _exit(1);
+            }
+        }
+
+        /* Redirigir stdin al extremo de lectura de salida */
+        dup2(salida[0], STDIN_FILENO);
+        close(salida[0]);
+
+        /* Redirigir stdout al extremo de escritura de entrada */
+        dup2(entrada[1], STDOUT_FILENO);
+        close(entrada[1]);
+
+        /* Ejecutar el programa hijo */
+        char* argsPorDefecto[] = {(char*)nombreArchivoEjecutable, NULL};
+        char* const* args = (listaLineaComando != NULL)
+            ? (char* const*)listaLineaComando
+            : argsPorDefecto;
+
+        /* Con el ejecutable ya resuelto (lotes), evitar la búsqueda en PATH.
+         * Si falla (p. ej. un script con #!), se recurre a execvp */
+        if (fdEjecutable >= 0) {
+            syscall(SYS_execveat, fdEjecutable, "", args,
+                    entornoHijo != NULL ? entornoHijo : environ, AT_EMPTY_PATH);
+        }
+
+        if (entornoHijo != NULL) {
+            execvpe(nombreArchivoEjecutable, args, entornoHijo);
+        } else {
+            execvp(nombreArchivoEjecutable, args);
+        }
+
+        /* Si llegamos aquí, execvp falló. _exit: no vaciar los buffers de
+         * stdio copiados del padre */
+        perror("execvp");
+        _exit(1);
+    }
+
+    /* ===== CÓDIGO DEL PROCESO PADRE ===== */
+
+    /* Cerrar extremos que el padre no usa */
+    close(entrada[1]);  /* El padre no escribe en entrada */
+    close(salida[0]);   /* El padre no lee de salida */
+    free(entornoHijo);
+
+    if (u->fdCgroup != -1) {
+        close(u->fdCgroup);
+        u->fdCgroup = -1;
+    }
+
+    /* Comprobar que el hijo pudo aplicar la ubicación antes de exec */
+    if (u->aplicar) {
+        Estado_t fallo;
+        ssize_t leidos;
+        close(pipeEstado[1]);
+        do {
+            leidos = read(pipeEstado[0], &fallo, sizeof(fallo));
+        } while (leidos == -1 && errno == EINTR);
+        close(pipeEstado[0]);
+
+        if (leidos > 0) {
+            int status;
+            waitpid(hijo, &status, 0);
+            close(entrada[0]);
+            close(salida[1]);
+            return E_UBICACION;
+        }
+    }
+
+    *pid = hijo;
+    return E_OK;
+}
+
+/**
+ * @brief Guarda en pp una copia de lo necesario para relanzar el hijo
+ *
+ * Nombre, argumentos, opciones y las listas y cadenas a las que apuntan
+ * van en una sola reserva; las opciones copiadas apuntan dentro de ella.
+ */
+static Estado_t guardarLanzamiento(
+    ProcesoPar_t *pp,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones
+) {
+    size_t numArgs = 0;
+    size_t bytesCadenas = strlen(nombreArchivoEjecutable) + 1;
+    if (listaLineaComando != NULL) {
+        while (listaLineaComando[numArgs] != NULL) {
+            bytesCadenas += strlen(listaLineaComando[numArgs]) + 1;
+            numArgs++;
+        }
+    }
+    if (opciones->cgroup != NULL) {
+        bytesCadenas += strlen(opciones->cgroup) + 1;
+    }
+
+    size_t numCpusHijo = opciones->cpusHijo != NULL ? (size_t)opciones->numCpusHijo : 0;
+    size_t numCpusEscucha = opciones->cpusEscucha != NULL ? (size_t)opciones->numCpusEscucha : 0;
+    size_t bytesArgs = (listaLineaComando != NULL) ? (numArgs + 1) * sizeof(char*) : 0;
+
+    LanzamientoProcesoPar_t *l = (LanzamientoProcesoPar_t*)malloc(
+        sizeof(LanzamientoProcesoPar_t) + bytesArgs +
+        (numCpusHijo + numCpusEscucha) * sizeof(int) + bytesCadenas);
+    if (l == NULL) {
+        return E_NO_MEMORIA;
+    }
+
+    /* Punteros, enteros y cadenas, en ese orden, para respetar la alineación */
+    char *libre = (char*)(l + 1);
+    l->opciones = *opciones;
+
+    l->listaLineaComando = NULL;
+    if (listaLineaComando != NULL) {
+        l->listaLineaComando = (const char**)libre;
+        libre += bytesArgs;
+    }
+    if (numCpusHijo > 0) {
+        memcpy(libre, opciones->cpusHijo, numCpusHijo * sizeof(int));
+        l->opciones.cpusHijo = (const int*)libre;
+        libre += numCpusHijo * sizeof(int);
+    }
+    if (numCpusEscucha > 0) {
+        memcpy(libre, opciones->cpusEscucha, numCpusEscucha * sizeof(int));
+        l->opciones.cpusEscucha = (const int*)libre;
+        libre += numCpusEscucha * sizeof(int);
+    }
+
+    size_t n = strlen(nombreArchivoEjecutable) + 1;
+    memcpy(libre, nombreArchivoEjecutable, n);
+    l->nombreArchivoEjecutable = libre;
+    libre += n;
+
+    for (size_t i = 0; i < numArgs; i++) {
+        n = strlen(listaLineaComando[i]) + 1;
+        memcpy(libre, listaLineaComando[i], n);
+        l->listaLineaComando[i] = libre;
+        libre += n;
+    }
+    if (l->listaLineaComando != NULL) {
+        l->listaLineaComando[numArgs] = NULL;
+    }
+
+    if (opciones->cgroup != NULL) {
+        n = strlen(opciones->cgroup) + 1;
+        memcpy(libre, opciones->cgroup, n);
+        l->opciones.cgroup = libre;
+    }
+
+    pp->lanzamiento = l;
+    return E_OK;
+}
+#endif
+
+/**
+ * @brief Lanza el hijo de un proceso par ya reservado y puesto a cero
+ *
+ * Compartida por lanzarProcesoParConOpciones() y lanzarLoteProcesoPar().
+ * En caso de error deja cerrado todo lo que abrió, pero no libera pp.
+ */
+Estado_t iniciarProcesoPar(
+    ProcesoPar_t *pp,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    int fdEjecutable
+) {
+    /* Inicializar campos comunes */
+    pp->funcionEscucha = NULL;
+    pp->activo = 0;
+    pp->compresion = 0;
+    pp->umbralCompresion = opciones->umbralCompresion;
+    pp->delimitador = opciones->delimitador;
+
+#ifdef _WIN32
+    /* ========================================
+     * IMPLEMENTACIÓN PARA WINDOWS
+     * ======================================== */
+    
+    SECURITY_ATTRIBUTES sa;
+    HANDLE hTuberiaLecturaHijo, hTuberiaEscrituraHijo;
+    HANDLE hTuberiaLecturaPadre, hTuberiaEscrituraPadre;
+    STARTUPINFOA si;
+    PROCESS_INFORMATION pi;
+    BOOL exito;
+
+    (void)fdEjecutable;  /* Solo se usa en Linux */
+
+    /* La negociación de compresión solo está implementada en Linux */
+    if (opciones->compresion) {
+        return E_NO_SOPORTADO;
+    }
+
+    /* Configurar atributos de seguridad para que los handles sean heredables */
+    sa.nLength = sizeof(SECURITY_ATTRIBUTES);
+    sa.bInheritHandle = TRUE;
+    sa.lpSecurityDescriptor = NULL;
+
+    /* Crear tubería 1: Padre escribe -> Hijo lee (Salida del padre) */
+    if (!CreatePipe(&hTuberiaLecturaHijo, &hTuberiaEscrituraPadre, &sa, 0)) {
+        return E_CREAR_PIPE;
+    }
+
+    /* Asegurar que el extremo de escritura del padre no sea heredable */
+    if (!SetHandleInformation(hTuberiaEscrituraPadre, HANDLE_FLAG_INHERIT, 0)) {
+        CloseHandle(hTuberiaLecturaHijo);
+        CloseHandle(hTuberiaEscrituraPadre);
+        return E_CREAR_PIPE;
+    }
+
+    /* Crear tubería 2: Hijo escribe -> Padre lee (Entrada al padre) */
+    if (!CreatePipe(&hTuberiaLecturaPadre, &hTuberiaEscrituraHijo, &sa, 0)) {
+        CloseHandle(hTuberiaLecturaHijo);
+        CloseHandle(hTuberiaEscrituraPadre);
+        return E_CREAR_PIPE;
+    }
+
+    /* Asegurar que el extremo de lectura del padre no sea heredable */
+    if (!SetHandleInformation(hTuberiaLecturaPadre, HANDLE_FLAG_INHERIT, 0)) {
+        CloseHandle(hTuberiaLecturaHijo);
+        CloseHandle(hTuberiaEscrituraPadre);
+        CloseHandle(hTuberiaLecturaPadre);
+        CloseHandle(hTuberiaEscrituraHijo);
+        return E_CREAR_PIPE;
+    }
+
+    /* Configurar STARTUPINFO */
+    ZeroMemory(&si, sizeof(si));
+    si.cb = sizeof(si);
+    si.hStdError = hTuberiaEscrituraHijo;
+    si.hStdOutput = hTuberiaEscrituraHijo;
+    si.hStdInput = hTuberiaLecturaHijo;
+    si.dwFlags |= STARTF_USESTDHANDLES;
+
+    /* Construir línea de comandos */
+    char comandoCompleto[1024] = "";
+    if (listaLineaComando != NULL) {
+        int i = 0;
+        while (listaLineaComando[i] != NULL) {
+            if (i > 0) strcat(comandoCompleto, " ");
+            strcat(comandoCompleto, listaLineaComando[i]);
+            i++;
+        }
+    } else {
+        strcpy(comandoCompleto, nombreArchivoEjecutable);
+    }
+
+    /* Crear el proceso hijo */
+    ZeroMemory(&pi, sizeof(pi));
+    exito = CreateProcessA(
+        nombreArchivoEjecutable,  /* Nombre del módulo */
+        comandoCompleto,          /* Línea de comandos */
+        NULL,                     /* Atributos de seguridad del proceso */
+        NULL,                     /* Atributos de seguridad del hilo */
+        TRUE,                     /* Heredar handles */
+        0,                        /* Flags de creación */
+        NULL,                     /* Usar ambiente del padre */
+        NULL,                     /* Usar directorio del padre */
+        &si,                      /* STARTUPINFO */
+        &pi                       /* PROCESS_INFORMATION */
+    );
+
+    if (!exito) {
+        CloseHandle(hTuberiaLecturaHijo);
+        CloseHandle(hTuberiaEscrituraPadre);
+        CloseHandle(hTuberiaLecturaPadre);
+        CloseHandle(hTuberiaEscrituraHijo);
+        return E_CREAR_PROCESO;
+    }
+
+    /* Cerrar los handles que el padre no necesita */
+    CloseHandle(hTuberiaLecturaHijo);
+    CloseHandle(hTuberiaEscrituraHijo);
+
+    /* Guardar información en la estructura */
+    pp->hProceso = pi.hProcess;
+    pp->hHilo = pi.hThread;
+    pp->dwProcesoId = pi.dwProcessId;
+    pp->hTuberiaEntrada = hTuberiaLecturaPadre;  /* Padre LEE desde aquí */
+    pp->hTuberiaSalida = hTuberiaEscrituraPadre; /* Padre ESCRIBE aquí */
+    pp->hHiloEscucha = NULL;
+    pp->activo = 1;
+
+#else
+    /* ========================================
+     * IMPLEMENTACIÓN PARA LINUX
+     * ======================================== */
+    
+    UbicacionHijo_t ubicacion;
+    Estado_t estado = prepararUbicacion(pp, opciones, &ubicacion);
+    if (estado == E_OK) {
+        estado = guardarLanzamiento(pp, nombreArchivoEjecutable, listaLineaComando, opciones);
+    }
+    if (estado == E_OK) {
+        estado = crearHijo(nombreArchivoEjecutable, listaLineaComando, opciones, fdEjecutable,
+                           &ubicacion, pp->pipeEntrada, pp->pipeSalida, &pp->pid);
+    }
+    if (estado != E_OK) {
+        descartarUbicacion(pp, &ubicacion);
+        free(pp->lanzamiento);
+        pp->lanzamiento = NULL;
+        return estado;
+    }
+
+    pthread_mutex_init(&pp->mutexEnvio, NULL);
+    pthread_mutex_init(&pp->mutexOrden, NULL);
+    pthread_mutex_init(&pp->mutexLlamadas, NULL);
+
+    /* Las esperas con plazo de llamarProcesoPar() usan el reloj monotónico */
+    pthread_condattr_t atributosCondicion;
+    pthread_condattr_init(&atributosCondicion);
+    pthread_condattr_setclock(&atributosCondicion, CLOCK_MONOTONIC);
+    pthread_cond_init(&pp->condLlamadas, &atributosCondicion);
+    pthread_condattr_destroy(&atributosCondicion);
+
+    pp->hiloCreado = 0;
+    pp->activo = 1;
+    PP_TRAZA(LANZAMIENTO, pp->pid, 0);
+
+    /* Esperar a que el hijo acepte (o ignore) la oferta de compresión */
+    if (opciones->compresion) {
+        pp->compresion = negociarCompresion(pp, pp->pipeEntrada[0], pp->pipeSalida[1],
+                                            opciones->msNegociacion);
+    }
+#endif
+
+    return E_OK;
+}
+
+/**
+ * @brief Lanza un nuevo proceso par con opciones de lanzamiento
+ */
+Estado_t lanzarProcesoParConOpciones(
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    ProcesoPar_t **procesoPar
+) {
+    /* Validar parámetros */
+    if (nombreArchivoEjecutable == NULL || procesoPar == NULL) {
+        return E_PAR_INC;
+    }
+
+    OpcionesProcesoPar_t porDefecto;
+    if (opciones == NULL) {
+        inicializarOpcionesProcesoPar(&porDefecto);
+        opciones = &porDefecto;
+    }
+    if (opciones->umbralCompresion < 0 || opciones->msNegociacion < 0 ||
+        opciones->delimitador < -1 || opciones->delimitador > 255) {
+        return E_PAR_INC;
+    }
+
+    /* Asignar memoria para la estructura ProcesoPar_t (buffers y contadores a cero) */
+    ProcesoPar_t *pp = (ProcesoPar_t*)calloc(1, sizeof(ProcesoPar_t));
+    if (pp == NULL) {
+        return E_NO_MEMORIA;
+    }
+
+    Estado_t estado = iniciarProcesoPar(pp, nombreArchivoEjecutable, listaLineaComando, opciones, -1);
+    if (estado != E_OK) {
+        free(pp);
+        return estado;
+    }
+
+    /* Retornar el puntero al proceso par creado */
+    *procesoPar = pp;
+    return E_OK;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Mata al hijo y lanza otro igual en el mismo proceso par
+ */
+Estado_t relanzarProcesoPar(ProcesoPar_t *pp) {
+    LanzamientoProcesoPar_t *l = pp->lanzamiento;
+    if (l == NULL) {
+        return E_PAR_INC;
+    }
+
+    pthread_mutex_lock(&pp->mutexOrden);
+    if (!pp->activo || pp->pipeSalida[1] == -1 || pp->modoSondeo) {
+        pthread_mutex_unlock(&pp->mutexOrden);
+        return pp->modoSondeo ? E_MODO : E_PROCESO_INACT;
+    }
+
+    /* Desde aquí los envíos fallan en vez de escribir en la tubería del
+     * hijo muerto, y ningún otro relanzamiento empieza */
+    pp->activo = 0;
+    int habiaHilo = pp->hiloCreado;
+    pthread_mutex_unlock(&pp->mutexOrden);
+
+    /* Un hijo atascado no atiende a SIGTERM */
+    kill(pp->pid, SIGKILL);
+    int status;
+    waitpid(pp->pid, &status, 0);
+    pp->pid = -1;
+
+    /* Con el hijo muerto, el hilo de escucha lee EOF, falla las llamadas
+     * pendientes y termina. Sin cerrojos: su función de escucha puede estar
+     * enviando. hiloCreado sigue a 1 para que nadie cree otro entretanto */
+    if (habiaHilo) {
+        pthread_join(pp->hiloEscucha, NULL);
+    }
+
+    /* El muestreador tiene abiertos los archivos de /proc del hijo muerto */
+    int capacidadMuestreo = 0;
+    UmbralRecurso_t umbrales[PROCESOPAR_NUM_RECURSOS];
+    pthread_mutex_lock(&muestreador.mutex);
+    if (pp->muestreo != NULL) {
+        capacidadMuestreo = pp->muestreo->capacidad;
+        memcpy(umbrales, pp->muestreo->umbrales, sizeof(umbrales));
+    }
+    pthread_mutex_unlock(&muestreador.mutex);
+    if (capacidadMuestreo > 0) {
+        desregistrarMuestreoProcesoPar(pp);
+    }
+
+    /* Lo que quedara a medias del hijo anterior se descarta */
+    pp->inicioEntrada = 0;
+    pp->longitudEntrada = 0;
+    pp->revisadoEntrada = 0;
+    pp->primerLimite = 0;
+    pp->numLimites = 0;
+    pp->hayByteGuardado = 0;
+    pp->saludoTardio = 0;
+
+    /* Si el hijo anterior no aceptó la compresión, no ofrecerla ni esperar
+     * el saludo del nuevo */
+    OpcionesProcesoPar_t opciones = l->opciones;
+    opciones.compresion = pp->compresion;
+
+    int entrada[2];
+    int salida[2];
+    pid_t pid = -1;
+    UbicacionHijo_t ubicacion;
+    Estado_t estado = prepararUbicacion(NULL, &opciones, &ubicacion);
+    if (estado == E_OK) {
+        estado = crearHijo(l->nombreArchivoEjecutable, l->listaLineaComando, &opciones, -1,
+                           &ubicacion, entrada, salida, &pid);
+    }
+    if (estado != E_OK) {
+        descartarUbicacion(NULL, &ubicacion);
+        pthread_mutex_lock(&pp->mutexOrden);
+        pp->hiloCreado = 0;
+        pthread_mutex_unlock(&pp->mutexOrden);
+        return estado;
+    }
+
+    /* La negociación espera al hijo: se hace sobre sus tuberías antes de
+     * ponerlas en pp, sin cerrojos */
+    int compresion = opciones.compresion
+        ? negociarCompresion(pp, entrada[0], salida[1], opciones.msNegociacion)
+        : 0;
+
+    /* Nadie encola llamadas ni escribe tramas mientras se cambia el hijo */
+    pthread_mutex_lock(&pp->mutexOrden);
+    pthread_mutex_lock(&pp->mutexEnvio);
+
+    /* Las tuberías nuevas ocupan los mismos descriptores: quien los haya
+     * leído de pp sin cerrojo escribe en el hijo nuevo */
+    dup3(entrada[0], pp->pipeEntrada[0], O_CLOEXEC);
+    close(entrada[0]);
+    dup3(salida[1], pp->pipeSalida[1], O_CLOEXEC);
+    close(salida[1]);
+    pp->pid = pid;
+    pp->compresion = compresion;
+    PP_TRAZA(LANZAMIENTO, pp->pid, 0);
+
+    pthread_mutex_lock(&pp->mutexLlamadas);
+    pp->finEntrada = 0;
+    pthread_mutex_unlock(&pp->mutexLlamadas);
+
+    /* El hilo de escucha ya lee, aunque activo siga a 0, para que el hijo
+     * no se bloquee respondiendo a lo reenviado */
+    __atomic_store_n(&pp->reenviandoDiario, 1, __ATOMIC_RELEASE);
+    if (habiaHilo) {
+        pp->hiloCreado = 0;
+        estado = crearHiloEscucha(pp);
+    }
+
+    /* Lo no confirmado, al hijo nuevo, antes que cualquier envío nuevo */
+    __atomic_fetch_add(&pp->usuariosDiario, 1, __ATOMIC_SEQ_CST);
+    DiarioProcesoPar_t *diario = __atomic_load_n(&pp->diario, __ATOMIC_SEQ_CST);
+    if (diario != NULL && estado == E_OK) {
+        reenviarDiario(pp, diario);
+    }
+    __atomic_fetch_sub(&pp->usuariosDiario, 1, __ATOMIC_RELEASE);
+
+    /* Solo ahora se admiten envíos nuevos */
+    pp->activo = 1;
+    __atomic_store_n(&pp->reenviandoDiario, 0, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&pp->mutexEnvio);
+    pthread_mutex_unlock(&pp->mutexOrden);
+
+    if (capacidadMuestreo > 0 && registrarMuestreoProcesoPar(pp, capacidadMuestreo) == E_OK) {
+        pthread_mutex_lock(&muestreador.mutex);
+        memcpy(pp->muestreo->umbrales, umbrales, sizeof(umbrales));
+        pthread_mutex_unlock(&muestreador.mutex);
+    }
+
+    return estado;
+}
+#endif
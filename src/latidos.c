@@ -0,0 +1,304 @@
+/**
+ * @file latidos.c
+ * @brief Rueda de temporizadores de los latidos y funciones internas asociadas
+ *
+ * Un timerfd despierta al hilo cada PP_MS_TIC_LATIDO ms; el hilo procesa
+ * los tics transcurridos recorriendo solo la ranura de cada uno. Con miles
+ * de procesos pares, cada tic toca unos pocos nodos, y activar o quitar un
+ * latido no depende de cuántos haya.
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <errno.h>
+    #include <poll.h>
+    #include <stdint.h>
+    #include <sys/timerfd.h>
+#endif
+
+#ifndef _WIN32
+
+Latidor_t latidor = {
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    0,
+    -1,
+    0,
+    0,
+    { NULL }
+};
+
+/**
+ * @brief Enlaza un latido para que venza dentro de `tics` tics (con latidor.mutex)
+ */
+static void insertarRueda(LatidoProcesoPar_t *l, unsigned int tics) {
+    unsigned long long vencimiento = latidor.tic + tics;
+    l->ranura = (unsigned int)(vencimiento & (PP_RANURAS_LATIDO - 1));
+    l->vueltas = (tics - 1) / PP_RANURAS_LATIDO;
+
+    l->anterior = NULL;
+    l->siguiente = latidor.ranuras[l->ranura];
+    if (l->siguiente != NULL) {
+        l->siguiente->anterior = l;
+    }
+    latidor.ranuras[l->ranura] = l;
+}
+
+/**
+ * @brief Desenlaza un latido de su ranura (con latidor.mutex)
+ */
+static void quitarRueda(LatidoProcesoPar_t *l) {
+    if (l->anterior != NULL) {
+        l->anterior->siguiente = l->siguiente;
+    } else {
+        latidor.ranuras[l->ranura] = l->siguiente;
+    }
+    if (l->siguiente != NULL) {
+        l->siguiente->anterior = l->anterior;
+    }
+    l->anterior = NULL;
+    l->siguiente = NULL;
+}
+
+/**
+ * @brief Hilo que relanza un hijo atascado fuera del hilo de latidos
+ *
+ * Relanzar espera a que muera el hijo y a su hilo de escucha: hacerlo en
+ * el hilo de latidos retrasaría los de todos los demás procesos pares.
+ */
+static void *hiloRelanzamiento(void *param) {
+    LatidoProcesoPar_t *l = (LatidoProcesoPar_t*)param;
+    Estado_t estado = relanzarProcesoPar(l->pp);
+
+    pthread_mutex_lock(&latidor.mutex);
+    if (estado == E_OK) {
+        l->relanzamientos++;
+        l->atascado = 0;
+        l->fallos = 0;
+        l->recibidosVistos = PP_LEER(l->recibidos);
+        l->nsActividad = tiempoNs();
+        __atomic_store_n(&l->nsSonda, 0ULL, __ATOMIC_RELAXED);
+    }
+    l->relanzando = 0;
+    pthread_cond_broadcast(&latidor.condicion);
+    pthread_mutex_unlock(&latidor.mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief Envía la sonda sin bloquear el hilo de latidos
+ *
+ * Si la tubería hacia el hijo está llena (un hijo atascado deja de leer),
+ * no se envía, pero la sonda cuenta igualmente como pendiente. La sonda no
+ * se anota en el diario: no se reenvía ni ocupa una secuencia.
+ */
+static void enviarSonda(LatidoProcesoPar_t *l, unsigned long long ahora) {
+    ProcesoPar_t *pp = l->pp;
+    struct pollfd pfd = { pp->pipeSalida[1], POLLOUT, 0 };
+
+    /* mutexEnvio ocupado (p. ej. reenviando el diario) es como la tubería llena */
+    if (poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLOUT) &&
+        pthread_mutex_trylock(&pp->mutexEnvio) == 0) {
+        if (reescribirMensajeProcesoPar(pp, l->sonda, l->longitudSonda) == E_OK) {
+            PP_CAPTURAR(pp, PROCESOPAR_CAPTURA_ENVIO, l->sonda, l->longitudSonda);
+            l->sondas++;
+        }
+        pthread_mutex_unlock(&pp->mutexEnvio);
+    }
+    if (PP_LEER(l->nsSonda) == 0) {
+        __atomic_store_n(&l->nsSonda, ahora, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Procesa el vencimiento de un latido (con latidor.mutex)
+ */
+static void vencerLatido(LatidoProcesoPar_t *l, unsigned long long ahora) {
+    if (l->relanzando || !l->pp->activo) {
+        return;
+    }
+
+    /* Cualquier mensaje del hijo desde el último vencimiento vale como respuesta */
+    unsigned long long recibidos = PP_LEER(l->recibidos);
+    if (recibidos != l->recibidosVistos) {
+        l->recibidosVistos = recibidos;
+        l->nsActividad = ahora;
+        l->fallos = 0;
+        l->atascado = 0;
+        __atomic_store_n(&l->nsSonda, 0ULL, __ATOMIC_RELAXED);
+        return;
+    }
+
+    /* Un intervalo entero en silencio con una sonda pendiente */
+    if (PP_LEER(l->nsSonda) != 0) {
+        l->fallos++;
+    }
+
+    if (l->fallos >= l->fallosMaximos && !l->atascado) {
+        l->atascado = 1;
+        if (l->funcion != NULL) {
+            l->funcion(l->pp, (ahora - l->nsActividad) / 1000000ULL);
+        }
+        if (l->relanzar) {
+            pthread_t hilo;
+            l->relanzando = 1;
+            if (pthread_create(&hilo, NULL, hiloRelanzamiento, l) == 0) {
+                pthread_detach(hilo);
+                return;
+            }
+            l->relanzando = 0;
+        }
+    }
+
+    enviarSonda(l, ahora);
+}
+
+/**
+ * @brief Avanza un tic y vence los latidos de su ranura (con latidor.mutex)
+ */
+static void procesarTic(unsigned long long ahora) {
+    latidor.tic++;
+    LatidoProcesoPar_t *l = latidor.ranuras[latidor.tic & (PP_RANURAS_LATIDO - 1)];
+
+    while (l != NULL) {
+        /* Lo que se reinserta va a la cabeza de una ranura: nunca por
+         * delante de `siguiente` en esta */
+        LatidoProcesoPar_t *siguiente = l->siguiente;
+        if (l->vueltas > 0) {
+            l->vueltas--;
+        } else {
+            quitarRueda(l);
+            vencerLatido(l, ahora);
+            insertarRueda(l, l->tics);
+        }
+        l = siguiente;
+    }
+}
+
+/**
+ * @brief Hilo de latidos: termina solo cuando no queda ningún latido
+ */
+static void *hiloLatidos(void *param) {
+    (void)param;
+    uint64_t expiraciones;
+
+    for (;;) {
+        ssize_t leidos = read(latidor.fdTemporizador, &expiraciones, sizeof(expiraciones));
+        if (leidos == -1 && errno == EINTR) {
+            continue;
+        }
+
+        pthread_mutex_lock(&latidor.mutex);
+        if (latidor.registrados == 0) {
+            close(latidor.fdTemporizador);
+            latidor.fdTemporizador = -1;
+            latidor.activo = 0;
+            pthread_mutex_unlock(&latidor.mutex);
+            return NULL;
+        }
+
+        /* Si el hilo se retrasó, ponerse al día tic a tic */
+        unsigned long long ahora = tiempoNs();
+        if (leidos == (ssize_t)sizeof(expiraciones)) {
+            for (uint64_t i = 0; i < expiraciones; i++) {
+                procesarTic(ahora);
+            }
+        }
+        pthread_mutex_unlock(&latidor.mutex);
+    }
+}
+
+Estado_t registrarLatidoProcesoPar(LatidoProcesoPar_t *l) {
+    ProcesoPar_t *pp = l->pp;
+
+    pthread_mutex_lock(&latidor.mutex);
+
+    if (!latidor.activo) {
+        int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (fd == -1) {
+            pthread_mutex_unlock(&latidor.mutex);
+            return E_CREAR_HILO;
+        }
+        struct itimerspec periodo;
+        periodo.it_interval.tv_sec = 0;
+        periodo.it_interval.tv_nsec = PP_MS_TIC_LATIDO * 1000000L;
+        periodo.it_value = periodo.it_interval;
+        timerfd_settime(fd, 0, &periodo, NULL);
+
+        pthread_t hilo;
+        latidor.fdTemporizador = fd;
+        if (pthread_create(&hilo, NULL, hiloLatidos, NULL) != 0) {
+            close(fd);
+            latidor.fdTemporizador = -1;
+            pthread_mutex_unlock(&latidor.mutex);
+            return E_CREAR_HILO;
+        }
+        /* El hilo libera lo suyo al salir: nadie lo espera */
+        pthread_detach(hilo);
+        latidor.activo = 1;
+    }
+
+    /* El nuevo sustituye al anterior, si lo había */
+    while (pp->latido != NULL && pp->latido->relanzando) {
+        pthread_cond_wait(&latidor.condicion, &latidor.mutex);
+    }
+    LatidoProcesoPar_t *anterior = pp->latido;
+    if (anterior != NULL) {
+        quitarRueda(anterior);
+        latidor.registrados--;
+    }
+
+    l->nsActividad = tiempoNs();
+    insertarRueda(l, l->tics);
+    latidor.registrados++;
+
+    pthread_mutex_lock(&pp->mutexLlamadas);
+    pp->latido = l;
+    pthread_mutex_unlock(&pp->mutexLlamadas);
+
+    pthread_mutex_unlock(&latidor.mutex);
+    free(anterior);
+    return E_OK;
+}
+
+void desregistrarLatidoProcesoPar(ProcesoPar_t *pp) {
+    pthread_mutex_lock(&latidor.mutex);
+
+    LatidoProcesoPar_t *l = pp->latido;
+    if (l != NULL) {
+        while (l->relanzando) {
+            pthread_cond_wait(&latidor.condicion, &latidor.mutex);
+        }
+        quitarRueda(l);
+        latidor.registrados--;
+
+        /* Tras esto el hilo de escucha ya no puede ver el latido */
+        pthread_mutex_lock(&pp->mutexLlamadas);
+        pp->latido = NULL;
+        pthread_mutex_unlock(&pp->mutexLlamadas);
+    }
+
+    pthread_mutex_unlock(&latidor.mutex);
+    free(l);
+}
+
+int anotarMensajeLatido(LatidoProcesoPar_t *l, const char *mensaje, int longitud) {
+    PP_SUMAR(l->recibidos, 1);
+
+    if (longitud != l->longitudRespuesta || memcmp(mensaje, l->respuesta, (size_t)longitud) != 0) {
+        return 0;
+    }
+
+    unsigned long long enviada = PP_LEER(l->nsSonda);
+    if (enviada != 0) {
+        __atomic_store_n(&l->nsRespuesta, tiempoNs() - enviada, __ATOMIC_RELAXED);
+    }
+    return 1;
+}
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file llamadasProcesoPar.c
+ * @brief Cola de llamadas pendientes y despacho de los mensajes del hijo
+ *
+ * El hijo responde en orden, así que cada mensaje recibido pertenece a la
+ * llamada más antigua de la cola. Los mensajes que llegan sin llamada
+ * pendiente van a la función de escucha, como siempre.
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+
+void soltarLlamada(LlamadaPendiente_t *llamada) {
+    if (--llamada->referencias == 0) {
+        free(llamada->respuesta);
+        free(llamada);
+    }
+}
+
+void completarLlamada(ProcesoPar_t *pp, LlamadaPendiente_t *llamada,
+                      const char *respuesta, int longitud, Estado_t estado) {
+    if (estado == E_OK) {
+        llamada->respuesta = (char*)malloc((size_t)longitud + 1);
+        if (llamada->respuesta == NULL) {
+            estado = E_NO_MEMORIA;
+        } else {
+            memcpy(llamada->respuesta, respuesta, (size_t)longitud);
+            llamada->respuesta[longitud] = '\0';
+            llamada->longitudRespuesta = longitud;
+        }
+    }
+
+    /* La respuesta llena la caché aunque quien llamó ya no espere */
+    if (llamada->entrada != NULL) {
+        EntradaCache_t *entrada = llamada->entrada;
+        llamada->entrada = NULL;
+        if (estado == E_OK) {
+            guardarRespuestaCache(pp->cache, entrada, respuesta, longitud);
+        } else {
+            entrada->llamada = NULL;
+            quitarEntradaCache(pp->cache, entrada);
+        }
+    }
+
+    llamada->estado = estado;
+    llamada->completada = 1;
+    pthread_cond_broadcast(&pp->condLlamadas);
+}
+
+void despacharMensaje(ProcesoPar_t *pp, const char *mensaje, int longitud) {
+    PP_TRAZA(DESPACHO, pp->pid, longitud);
+    PP_CAPTURAR(pp, PROCESOPAR_CAPTURA_RECEPCION, mensaje, longitud);
+
+    pthread_mutex_lock(&pp->mutexLlamadas);
+
+    /* La respuesta a una sonda de latido no es para nadie */
+    if (pp->latido != NULL && anotarMensajeLatido(pp->latido, mensaje, longitud)) {
+        pthread_mutex_unlock(&pp->mutexLlamadas);
+        return;
+    }
+
+    /* Cualquier otro mensaje del hijo puede confirmar un envío */
+    if (__atomic_load_n(&pp->diario, __ATOMIC_RELAXED) != NULL) {
+        confirmarRespuestaDiario(pp);
+    }
+
+    LlamadaPendiente_t *llamada = pp->primeraLlamada;
+    if (llamada != NULL) {
+        pp->primeraLlamada = llamada->siguiente;
+        if (pp->primeraLlamada == NULL) {
+            pp->ultimaLlamada = NULL;
+        }
+        completarLlamada(pp, llamada, mensaje, longitud, E_OK);
+        soltarLlamada(llamada);
+        pthread_mutex_unlock(&pp->mutexLlamadas);
+        return;
+    }
+    pthread_mutex_unlock(&pp->mutexLlamadas);
+
+    FuncionEscucha_t funcion = pp->funcionEscucha;
+    if (funcion != NULL) {
+        PP_TRAZA(CALLBACK_INICIO, pp->pid, longitud);
+        funcion(mensaje, longitud);
+        PP_TRAZA(CALLBACK_FIN, pp->pid, longitud);
+    }
+}
+
+void fallarLlamadasPendientes(ProcesoPar_t *pp) {
+    pthread_mutex_lock(&pp->mutexLlamadas);
+    /* Las llamadas posteriores fallan sin encolarse */
+    pp->finEntrada = 1;
+    while (pp->primeraLlamada != NULL) {
+        LlamadaPendiente_t *llamada = pp->primeraLlamada;
+        pp->primeraLlamada = llamada->siguiente;
+        completarLlamada(pp, llamada, NULL, 0, E_PROCESO_INACT);
+        soltarLlamada(llamada);
+    }
+    pp->ultimaLlamada = NULL;
+    /* También espera esto quien drena el proceso par */
+    pthread_cond_broadcast(&pp->condLlamadas);
+    pthread_mutex_unlock(&pp->mutexLlamadas);
+}
+
+void liberarLlamadasProcesoPar(ProcesoPar_t *pp) {
+    fallarLlamadasPendientes(pp);
+
+    if (pp->cache != NULL) {
+        CacheRespuestas_t *cache = pp->cache;
+        vaciarCacheRespuestas(cache);
+        free(cache->cubetas);
+        free(cache);
+        pp->cache = NULL;
+    }
+
+    pthread_cond_destroy(&pp->condLlamadas);
+    pthread_mutex_destroy(&pp->mutexLlamadas);
+    pthread_mutex_destroy(&pp->mutexOrden);
+}
+
+#endif
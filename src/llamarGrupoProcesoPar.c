@@ -0,0 +1,45 @@
+/**
+ * @file llamarGrupoProcesoPar.c
+ * @brief Implementación de la llamada por turnos a un grupo de procesos pares
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Llama al siguiente proceso par del grupo (por turnos)
+ */
+Estado_t llamarGrupoProcesoPar(
+    GrupoProcesoPar_t *grupo,
+    const char *peticion,
+    int longitud,
+    const char *clave,
+    int longitudClave,
+    MensajeRecibido_t *respuesta,
+    int msEspera
+) {
+    /* Validar parámetros (el resto los valida llamarProcesoPar) */
+    if (grupo == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    (void)peticion;
+    (void)longitud;
+    (void)clave;
+    (void)longitudClave;
+    (void)respuesta;
+    (void)msEspera;
+    return E_NO_SOPORTADO;
+#else
+    /* El miembro no se drena mientras la llamada espere su respuesta */
+    MiembroGrupo_t *miembro = tomarMiembroGrupo(grupo);
+    if (miembro == NULL) {
+        return E_PROCESO_INACT;
+    }
+
+    Estado_t estado = llamarProcesoPar(miembro->pp, peticion, longitud, clave, longitudClave,
+                                       respuesta, msEspera);
+    soltarMiembroGrupo(grupo, miembro);
+    return estado;
+#endif
+}
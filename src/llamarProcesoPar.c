@@ -0,0 +1,217 @@
+/**
+ * @file llamarProcesoPar.c
+ * @brief Implementación de la llamada petición/respuesta con caché opcional
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <errno.h>
+    #include <pthread.h>
+    #include <time.h>
+#endif
+
+#ifndef _WIN32
+/**
+ * @brief Espera a que una llamada se complete
+ * @return 1 si se completó, 0 si se agotó el tiempo
+ */
+static int esperarLlamada(ProcesoPar_t *pp, LlamadaPendiente_t *llamada, int msEspera) {
+    if (msEspera < 0) {
+        while (!llamada->completada) {
+            pthread_cond_wait(&pp->condLlamadas, &pp->mutexLlamadas);
+        }
+        return 1;
+    }
+
+    /* condLlamadas usa el reloj monotónico */
+    struct timespec limite;
+    clock_gettime(CLOCK_MONOTONIC, &limite);
+    limite.tv_sec += msEspera / 1000;
+    limite.tv_nsec += (long)(msEspera % 1000) * 1000000L;
+    if (limite.tv_nsec >= 1000000000L) {
+        limite.tv_sec++;
+        limite.tv_nsec -= 1000000000L;
+    }
+
+    while (!llamada->completada) {
+        if (pthread_cond_timedwait(&pp->condLlamadas, &pp->mutexLlamadas, &limite) == ETIMEDOUT) {
+            return llamada->completada;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Copia una respuesta en el buffer de quien llama
+ */
+static void copiarRespuesta(MensajeRecibido_t *destino, const char *respuesta, int longitud) {
+    int copiar = (longitud < destino->capacidad) ? longitud : destino->capacidad;
+    memcpy(destino->datos, respuesta, (size_t)copiar);
+    if (copiar < destino->capacidad) {
+        destino->datos[copiar] = '\0';
+    }
+    destino->longitud = longitud;
+}
+#endif
+
+/**
+ * @brief Envía una petición y espera la respuesta del hijo
+ */
+Estado_t llamarProcesoPar(
+    ProcesoPar_t *procesoPar,
+    const char *peticion,
+    int longitud,
+    const char *clave,
+    int longitudClave,
+    MensajeRecibido_t *respuesta,
+    int msEspera
+) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || peticion == NULL || longitud <= 0 ||
+        respuesta == NULL || respuesta->datos == NULL || respuesta->capacidad < 2) {
+        return E_PAR_INC;
+    }
+    if (clave == NULL) {
+        clave = peticion;
+        longitudClave = longitud;
+    } else if (longitudClave <= 0) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    (void)msEspera;
+    return E_NO_SOPORTADO;
+#else
+    ProcesoPar_t *pp = procesoPar;
+
+    /* Las respuestas las reparte el hilo de escucha */
+    if (pp->modoSondeo) {
+        return E_MODO;
+    }
+    if (!pp->hiloCreado) {
+        pthread_mutex_lock(&pp->mutexOrden);
+        Estado_t estado = pp->hiloCreado ? E_OK : crearHiloEscucha(pp);
+        pthread_mutex_unlock(&pp->mutexOrden);
+        if (estado != E_OK) {
+            return estado;
+        }
+    }
+
+    pthread_mutex_lock(&pp->mutexLlamadas);
+
+    if (pp->finEntrada) {
+        pthread_mutex_unlock(&pp->mutexLlamadas);
+        return E_PROCESO_INACT;
+    }
+
+    /* Consultar la caché: respuesta guardada o llamada idéntica en curso */
+    LlamadaPendiente_t *llamada = NULL;
+    unsigned long long hash = 0;
+    CacheRespuestas_t *cache = pp->cache;
+
+    if (cache != NULL) {
+        hash = hashClaveCache(clave, longitudClave);
+        EntradaCache_t *entrada = buscarEntradaCache(cache, clave, longitudClave, hash);
+
+        if (entrada != NULL && entrada->llamada == NULL && tiempoNs() >= entrada->nsCaducidad) {
+            quitarEntradaCache(cache, entrada);
+            cache->estadisticas.caducadas++;
+            entrada = NULL;
+        }
+
+        if (entrada != NULL && entrada->llamada == NULL) {
+            cache->estadisticas.aciertos++;
+            usarEntradaCache(cache, entrada);
+            copiarRespuesta(respuesta, entrada->respuesta, entrada->longitudRespuesta);
+            pthread_mutex_unlock(&pp->mutexLlamadas);
+            return E_OK;
+        }
+
+        if (entrada != NULL) {
+            /* Agruparse con la llamada en curso en vez de repetirla */
+            cache->estadisticas.agrupadas++;
+            llamada = entrada->llamada;
+            llamada->referencias++;
+        } else {
+            cache->estadisticas.fallos++;
+        }
+    }
+
+    /* Sin llamada que aprovechar: encolar una nueva y enviar la petición */
+    if (llamada == NULL) {
+        llamada = (LlamadaPendiente_t*)calloc(1, sizeof(LlamadaPendiente_t));
+        if (llamada == NULL) {
+            pthread_mutex_unlock(&pp->mutexLlamadas);
+            return E_NO_MEMORIA;
+        }
+        llamada->referencias = 1;
+
+        if (cache != NULL) {
+            /* Sin memoria para la entrada la llamada sigue adelante sin caché */
+            llamada->entrada = insertarEntradaCache(cache, clave, longitudClave, hash, llamada);
+        }
+        pthread_mutex_unlock(&pp->mutexLlamadas);
+
+        /* Encolar y enviar sin que otra llamada se cuele entre ambos pasos;
+         * mutexLlamadas no se retiene durante el envío para que el hilo de
+         * escucha pueda seguir vaciando la tubería */
+        pthread_mutex_lock(&pp->mutexOrden);
+        pthread_mutex_lock(&pp->mutexLlamadas);
+
+        Estado_t estado = E_OK;
+        if (pp->finEntrada) {
+            /* El hilo de escucha terminó mientras tanto: nadie respondería */
+            completarLlamada(pp, llamada, NULL, 0, E_PROCESO_INACT);
+        } else {
+            llamada->referencias++;
+            if (pp->ultimaLlamada != NULL) {
+                pp->ultimaLlamada->siguiente = llamada;
+            } else {
+                pp->primeraLlamada = llamada;
+            }
+            pp->ultimaLlamada = llamada;
+            pthread_mutex_unlock(&pp->mutexLlamadas);
+
+            estado = enviarMensajeProcesoPar(pp, peticion, longitud);
+
+            pthread_mutex_lock(&pp->mutexLlamadas);
+        }
+
+        if (estado != E_OK && !llamada->completada) {
+            /* Sigue siendo la última: nadie más ha podido encolar */
+            LlamadaPendiente_t **enlace = &pp->primeraLlamada;
+            LlamadaPendiente_t *anterior = NULL;
+            while (*enlace != llamada) {
+                anterior = *enlace;
+                enlace = &(*enlace)->siguiente;
+            }
+            *enlace = NULL;
+            pp->ultimaLlamada = anterior;
+            completarLlamada(pp, llamada, NULL, 0, estado);
+            soltarLlamada(llamada);
+        }
+        pthread_mutex_unlock(&pp->mutexOrden);
+    }
+
+    /* Esperar la respuesta (la propia o la de la llamada agrupada) */
+    Estado_t estado = E_TIEMPO;
+    if (esperarLlamada(pp, llamada, msEspera)) {
+        estado = llamada->estado;
+        if (estado == E_OK) {
+            copiarRespuesta(respuesta, llamada->respuesta, llamada->longitudRespuesta);
+        }
+    }
+    soltarLlamada(llamada);
+
+    pthread_mutex_unlock(&pp->mutexLlamadas);
+    return estado;
+#endif
+}
@@ -0,0 +1,232 @@
+/**
+ * @file muestreoRecursos.c
+ * @brief Hilo muestreador de recursos de los hijos y funciones internas asociadas
+ *
+ * El hilo relee con pread los archivos /proc/<pid>/{stat,statm,io,status}
+ * de cada proceso par registrado, abiertos una sola vez al registrarlo,
+ * sobre un único buffer de análisis. Así, muestrear mil hijos son unas
+ * cuatro mil lecturas por periodo, sin open/close ni reservas de memoria.
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <errno.h>
+    #include <time.h>
+#endif
+
+#ifndef _WIN32
+
+Muestreador_t muestreador = {
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    0,
+    0,
+    0,
+    0,
+    0,
+    NULL
+};
+
+/* Buffer de análisis: solo lo usa el hilo muestreador */
+static char bufferLectura[4096];
+
+/**
+ * @brief Relee un archivo de /proc abierto; devuelve 0 si el hijo ya no existe
+ */
+static int releer(int fd) {
+    if (fd == -1) {
+        return 0;
+    }
+    ssize_t n = pread(fd, bufferLectura, sizeof(bufferLectura) - 1, 0);
+    if (n <= 0) {
+        return 0;
+    }
+    bufferLectura[n] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Valor numérico que sigue a una etiqueta ("rchar: 123")
+ */
+static unsigned long long valorEtiqueta(const char *texto, const char *etiqueta) {
+    const char *p = strstr(texto, etiqueta);
+    if (p == NULL) {
+        return 0;
+    }
+    return strtoull(p + strlen(etiqueta), NULL, 10);
+}
+
+/**
+ * @brief Toma una muestra de un proceso par; devuelve 0 si no se pudo
+ */
+static int tomarMuestra(MuestreoRecursos_t *m, MuestraRecursos_t *muestra, long paginaBytes) {
+    memset(muestra, 0, sizeof(*muestra));
+    muestra->ns = tiempoNs();
+
+    /* stat: utime y stime son los campos 14 y 15; el nombre (campo 2) va
+     * entre paréntesis y puede contener espacios, así que se parte del ')' */
+    if (!releer(m->fdStat)) {
+        return 0;
+    }
+    char *p = strrchr(bufferLectura, ')');
+    if (p == NULL) {
+        return 0;
+    }
+    p++;
+    for (int campo = 2; campo < 13 && p != NULL; campo++) {
+        p = strchr(p + 1, ' ');
+    }
+    if (p == NULL) {
+        return 0;
+    }
+    char *fin;
+    unsigned long long utime = strtoull(p, &fin, 10);
+    unsigned long long stime = strtoull(fin, NULL, 10);
+    muestra->ticksCpu = utime + stime;
+
+    /* statm: el segundo campo son las páginas residentes */
+    if (releer(m->fdStatm)) {
+        strtoull(bufferLectura, &fin, 10);
+        muestra->rssBytes = strtoull(fin, NULL, 10) * (unsigned long long)paginaBytes;
+    }
+
+    if (releer(m->fdIo)) {
+        muestra->bytesLeidos = valorEtiqueta(bufferLectura, "rchar:");
+        muestra->bytesEscritos = valorEtiqueta(bufferLectura, "wchar:");
+    }
+
+    if (releer(m->fdStatus)) {
+        muestra->cambiosVoluntarios = valorEtiqueta(bufferLectura, "\nvoluntary_ctxt_switches:");
+        muestra->cambiosInvoluntarios = valorEtiqueta(bufferLectura, "\nnonvoluntary_ctxt_switches:");
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Comprueba un umbral y avisa al cruzarlo hacia arriba
+ */
+static void comprobarUmbral(MuestreoRecursos_t *m, int recurso, unsigned long long valor) {
+    UmbralRecurso_t *u = &m->umbrales[recurso];
+    if (u->funcion == NULL) {
+        return;
+    }
+
+    if (valor > u->limite) {
+        if (!u->superado) {
+            u->superado = 1;
+            u->funcion(m->pp, recurso, valor);
+        }
+    } else {
+        u->superado = 0;
+    }
+}
+
+/**
+ * @brief Muestrea todos los procesos pares registrados (con el mutex tomado)
+ */
+static void muestrearTodos(long paginaBytes, long ticksPorSegundo) {
+    for (MuestreoRecursos_t *m = muestreador.lista; m != NULL; m = m->siguiente) {
+        MuestraRecursos_t muestra;
+        if (!tomarMuestra(m, &muestra, paginaBytes)) {
+            continue;
+        }
+
+        /* Tasas respecto a la muestra anterior */
+        unsigned long long esPorSegundo = 0;
+        if (m->escritas > 0) {
+            const MuestraRecursos_t *previa = &m->muestras[(m->escritas - 1) % (unsigned long long)m->capacidad];
+            unsigned long long ns = muestra.ns - previa->ns;
+            if (ns > 0) {
+                double segundos = ns / 1e9;
+                double ticks = (double)(muestra.ticksCpu - previa->ticksCpu);
+                muestra.milesimasCpu = (unsigned int)(ticks / ticksPorSegundo / segundos * 1000.0);
+                esPorSegundo = (unsigned long long)(
+                    ((muestra.bytesLeidos - previa->bytesLeidos) +
+                     (muestra.bytesEscritos - previa->bytesEscritos)) / segundos);
+            }
+        }
+
+        m->muestras[m->escritas % (unsigned long long)m->capacidad] = muestra;
+        m->escritas++;
+
+        comprobarUmbral(m, PROCESOPAR_RECURSO_RSS, muestra.rssBytes);
+        if (m->escritas > 1) {
+            comprobarUmbral(m, PROCESOPAR_RECURSO_CPU, muestra.milesimasCpu);
+            comprobarUmbral(m, PROCESOPAR_RECURSO_ES, esPorSegundo);
+        }
+    }
+}
+
+void *hiloMuestreador(void *param) {
+    (void)param;
+    long paginaBytes = sysconf(_SC_PAGESIZE);
+    long ticksPorSegundo = sysconf(_SC_CLK_TCK);
+
+    pthread_mutex_lock(&muestreador.mutex);
+
+    /* Periodo fijo sobre el reloj de la condición, sin acumular deriva */
+    struct timespec siguiente;
+    clock_gettime(CLOCK_MONOTONIC, &siguiente);
+
+    while (!muestreador.detener) {
+        muestrearTodos(paginaBytes, ticksPorSegundo);
+
+        siguiente.tv_sec += muestreador.msIntervalo / 1000;
+        siguiente.tv_nsec += (long)(muestreador.msIntervalo % 1000) * 1000000L;
+        if (siguiente.tv_nsec >= 1000000000L) {
+            siguiente.tv_sec++;
+            siguiente.tv_nsec -= 1000000000L;
+        }
+
+        /* Si vamos con retraso, no intentar recuperar las muestras perdidas */
+        struct timespec ahora;
+        clock_gettime(CLOCK_MONOTONIC, &ahora);
+        if (ahora.tv_sec > siguiente.tv_sec ||
+            (ahora.tv_sec == siguiente.tv_sec && ahora.tv_nsec > siguiente.tv_nsec)) {
+            siguiente = ahora;
+        }
+
+        while (!muestreador.detener &&
+               pthread_cond_timedwait(&muestreador.condicion, &muestreador.mutex, &siguiente) != ETIMEDOUT) {
+        }
+    }
+
+    pthread_mutex_unlock(&muestreador.mutex);
+    return NULL;
+}
+
+void desregistrarMuestreoProcesoPar(ProcesoPar_t *pp) {
+    pthread_mutex_lock(&muestreador.mutex);
+
+    MuestreoRecursos_t *m = pp->muestreo;
+    if (m != NULL) {
+        MuestreoRecursos_t **enlace = &muestreador.lista;
+        while (*enlace != NULL && *enlace != m) {
+            enlace = &(*enlace)->siguiente;
+        }
+        if (*enlace == m) {
+            *enlace = m->siguiente;
+        }
+        pp->muestreo = NULL;
+    }
+
+    pthread_mutex_unlock(&muestreador.mutex);
+
+    if (m != NULL) {
+        int fds[4] = { m->fdStat, m->fdStatm, m->fdIo, m->fdStatus };
+        for (int i = 0; i < 4; i++) {
+            if (fds[i] != -1) {
+                close(fds[i]);
+            }
+        }
+        free(m->muestras);
+        free(m);
+    }
+}
+
+#endif
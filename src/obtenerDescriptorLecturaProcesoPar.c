@@ -0,0 +1,61 @@
+/**
+ * @file obtenerDescriptorLecturaProcesoPar.c
+ * @brief Implementación del paso a modo de sondeo y acceso al descriptor de lectura
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+#endif
+
+#ifndef _WIN32
+/**
+ * @brief Pasa el proceso par a modo de sondeo (descriptor no bloqueante)
+ */
+Estado_t activarModoSondeo(ProcesoPar_t *pp) {
+    if (pp->modoSondeo) {
+        return E_OK;
+    }
+
+    /* La tubería la lee el hilo de escucha: no se pueden mezclar los modos */
+    if (pp->hiloCreado) {
+        return E_MODO;
+    }
+
+    int flags = fcntl(pp->pipeEntrada[0], F_GETFL);
+    if (flags == -1 || fcntl(pp->pipeEntrada[0], F_SETFL, flags | O_NONBLOCK) == -1) {
+        return E_PAR_INC;
+    }
+
+    pp->modoSondeo = 1;
+    return E_OK;
+}
+#endif
+
+/**
+ * @brief Obtiene el descriptor del que se leen los mensajes del hijo
+ */
+Estado_t obtenerDescriptorLecturaProcesoPar(ProcesoPar_t *procesoPar, int *descriptor) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || descriptor == NULL) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    Estado_t estado = activarModoSondeo(procesoPar);
+    if (estado != E_OK) {
+        return estado;
+    }
+
+    *descriptor = procesoPar->pipeEntrada[0];
+    return E_OK;
+#endif
+}
@@ -0,0 +1,31 @@
+/**
+ * @file obtenerEstadisticasCache.c
+ * @brief Implementación de la consulta de contadores de la caché de respuestas
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Obtiene los contadores de la caché de respuestas
+ */
+Estado_t obtenerEstadisticasCache(ProcesoPar_t *procesoPar, EstadisticasCache_t *estadisticas) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || estadisticas == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    pthread_mutex_lock(&procesoPar->mutexLlamadas);
+
+    if (procesoPar->cache == NULL) {
+        pthread_mutex_unlock(&procesoPar->mutexLlamadas);
+        return E_PAR_INC;
+    }
+    *estadisticas = procesoPar->cache->estadisticas;
+
+    pthread_mutex_unlock(&procesoPar->mutexLlamadas);
+    return E_OK;
+#endif
+}
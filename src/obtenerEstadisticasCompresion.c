@@ -0,0 +1,33 @@
+/**
+ * @file obtenerEstadisticasCompresion.c
+ * @brief Implementación de la consulta de contadores de compresión
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Obtiene los contadores de compresión de un proceso par
+ */
+Estado_t obtenerEstadisticasCompresion(
+    ProcesoPar_t *procesoPar,
+    EstadisticasCompresion_t *estadisticas
+) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || estadisticas == NULL) {
+        return E_PAR_INC;
+    }
+
+    /* Los contadores se actualizan desde otros hilos: leer cada uno atómicamente */
+    EstadisticasCompresion_t *e = &procesoPar->estadisticasCompresion;
+    estadisticas->mensajesComprimidos = PP_LEER(e->mensajesComprimidos);
+    estadisticas->mensajesSinComprimir = PP_LEER(e->mensajesSinComprimir);
+    estadisticas->bytesOriginalesEnviados = PP_LEER(e->bytesOriginalesEnviados);
+    estadisticas->bytesComprimidosEnviados = PP_LEER(e->bytesComprimidosEnviados);
+    estadisticas->mensajesDescomprimidos = PP_LEER(e->mensajesDescomprimidos);
+    estadisticas->bytesComprimidosRecibidos = PP_LEER(e->bytesComprimidosRecibidos);
+    estadisticas->bytesOriginalesRecibidos = PP_LEER(e->bytesOriginalesRecibidos);
+    estadisticas->nsCompresion = PP_LEER(e->nsCompresion);
+    estadisticas->nsDescompresion = PP_LEER(e->nsDescompresion);
+
+    return E_OK;
+}
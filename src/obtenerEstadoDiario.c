@@ -0,0 +1,47 @@
+/**
+ * @file obtenerEstadoDiario.c
+ * @brief Implementación de la consulta del estado del diario de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Obtiene el estado del diario de un proceso par
+ */
+Estado_t obtenerEstadoDiario(ProcesoPar_t *procesoPar, EstadoDiario_t *estado) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || estado == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    Estado_t resultado = E_PAR_INC;
+
+    __atomic_fetch_add(&procesoPar->usuariosDiario, 1, __ATOMIC_SEQ_CST);
+    DiarioProcesoPar_t *d = __atomic_load_n(&procesoPar->diario, __ATOMIC_SEQ_CST);
+    if (d != NULL) {
+        estado->ultimaSecuencia = ultimaSecuenciaDiario(d);
+        estado->confirmada = __atomic_load_n(&d->estado->confirmada, __ATOMIC_RELAXED);
+        estado->sincronizaciones = PP_LEER(d->sincronizaciones);
+        estado->reenviados = PP_LEER(d->reenviados);
+
+        /* La lista de segmentos cambia al rotar y al retirar */
+        estado->segmentos = 0;
+        pthread_mutex_lock(&d->mutex);
+        for (SegmentoDiario_t *s = d->primero; s != NULL; s = s->siguiente) {
+            estado->segmentos++;
+        }
+        pthread_mutex_unlock(&d->mutex);
+        resultado = E_OK;
+    }
+    __atomic_fetch_sub(&procesoPar->usuariosDiario, 1, __ATOMIC_RELEASE);
+
+    return resultado;
+#endif
+}
@@ -0,0 +1,45 @@
+/**
+ * @file obtenerEstadoLatido.c
+ * @brief Implementación de la consulta del estado del latido de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+/**
+ * @brief Obtiene el estado del latido de un proceso par
+ */
+Estado_t obtenerEstadoLatido(ProcesoPar_t *procesoPar, EstadoLatido_t *estado) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || estado == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    pthread_mutex_lock(&latidor.mutex);
+
+    LatidoProcesoPar_t *l = procesoPar->latido;
+    if (l == NULL) {
+        pthread_mutex_unlock(&latidor.mutex);
+        return E_PAR_INC;
+    }
+
+    /* Mensajes que el hilo aún no ha visto: el hijo acaba de hablar */
+    unsigned long long ahora = tiempoNs();
+    estado->msSinRespuesta = (PP_LEER(l->recibidos) != l->recibidosVistos)
+        ? 0 : (ahora - l->nsActividad) / 1000000ULL;
+    estado->usUltimaRespuesta = PP_LEER(l->nsRespuesta) / 1000ULL;
+    estado->sondas = l->sondas;
+    estado->relanzamientos = l->relanzamientos;
+    estado->fallos = l->fallos;
+    estado->atascado = l->atascado;
+
+    pthread_mutex_unlock(&latidor.mutex);
+    return E_OK;
+#endif
+}
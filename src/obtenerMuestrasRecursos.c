@@ -0,0 +1,52 @@
+/**
+ * @file obtenerMuestrasRecursos.c
+ * @brief Implementación de la copia de las muestras de recursos de un proceso par
+ */
+
+#include "ProcesoParInterno.h"
+
+/**
+ * @brief Copia las muestras más recientes de un proceso par
+ */
+Estado_t obtenerMuestrasRecursos(
+    ProcesoPar_t *procesoPar,
+    MuestraRecursos_t *muestras,
+    int maximo,
+    int *numero
+) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || muestras == NULL || maximo <= 0 || numero == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    pthread_mutex_lock(&muestreador.mutex);
+
+    MuestreoRecursos_t *m = procesoPar->muestreo;
+    if (m == NULL) {
+        pthread_mutex_unlock(&muestreador.mutex);
+        return E_PAR_INC;
+    }
+
+    /* Las últimas min(maximo, capacidad, escritas) muestras, en orden */
+    unsigned long long n = m->escritas;
+    if (n > (unsigned long long)m->capacidad) {
+        n = (unsigned long long)m->capacidad;
+    }
+    if (n > (unsigned long long)maximo) {
+        n = (unsigned long long)maximo;
+    }
+
+    unsigned long long primera = m->escritas - n;
+    for (unsigned long long i = 0; i < n; i++) {
+        muestras[i] = m->muestras[(primera + i) % (unsigned long long)m->capacidad];
+    }
+
+    pthread_mutex_unlock(&muestreador.mutex);
+
+    *numero = (int)n;
+    return E_OK;
+#endif
+}
@@ -0,0 +1,305 @@
+/**
+ * @file procesarEntrada.c
+ * @brief Funciones internas para acumular y separar los mensajes recibidos del hijo
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+/**
+ * @brief Asegura que un buffer tenga al menos la capacidad pedida (1 si lo consigue)
+ */
+int asegurarCapacidad(char **buffer, size_t *capacidad, size_t necesaria) {
+    if (*capacidad >= necesaria) {
+        return 1;
+    }
+
+    size_t nueva = (*capacidad > 0) ? *capacidad : PP_TAMANO_LECTURA;
+    while (nueva < necesaria) {
+        nueva *= 2;
+    }
+
+    char *ampliado = (char*)realloc(*buffer, nueva);
+    if (ampliado == NULL) {
+        return 0;
+    }
+
+    *buffer = ampliado;
+    *capacidad = nueva;
+    return 1;
+}
+
+/**
+ * @brief Restaura el byte sustituido por '\0' en la entrega anterior
+ */
+static void restaurarByteGuardado(ProcesoPar_t *pp) {
+    if (pp->hayByteGuardado) {
+        pp->bufferEntrada[pp->posicionGuardada] = pp->byteGuardado;
+        pp->hayByteGuardado = 0;
+    }
+}
+
+/**
+ * @brief Guarda el byte que va a ocupar el '\0' de terminación, si pertenece
+ *        a datos aún no entregados, para restaurarlo en la siguiente llamada
+ */
+static void guardarByteSiguiente(ProcesoPar_t *pp) {
+    if (pp->inicioEntrada < pp->longitudEntrada) {
+        pp->posicionGuardada = pp->inicioEntrada;
+        pp->byteGuardado = pp->bufferEntrada[pp->inicioEntrada];
+        pp->hayByteGuardado = 1;
+    }
+}
+
+char *reservarEntrada(ProcesoPar_t *pp, size_t minimo, size_t *disponible) {
+    restaurarByteGuardado(pp);
+
+    /* Descartar lo ya consumido (los delimitadores pendientes se desplazan con los datos) */
+    if (pp->inicioEntrada == pp->longitudEntrada) {
+        pp->inicioEntrada = 0;
+        pp->longitudEntrada = 0;
+        pp->revisadoEntrada = 0;
+        pp->primerLimite = 0;
+        pp->numLimites = 0;
+    } else if (pp->inicioEntrada > 0) {
+        memmove(pp->bufferEntrada,
+                pp->bufferEntrada + pp->inicioEntrada,
+                pp->longitudEntrada - pp->inicioEntrada);
+        pp->longitudEntrada -= pp->inicioEntrada;
+        pp->revisadoEntrada -= pp->inicioEntrada;
+        for (int i = pp->primerLimite; i < pp->numLimites; i++) {
+            pp->limitesEntrada[i] -= (uint32_t)pp->inicioEntrada;
+        }
+        pp->inicioEntrada = 0;
+    }
+
+    /* +1 para el '\0' que se añade al entregar */
+    if (!asegurarCapacidad(&pp->bufferEntrada, &pp->capacidadEntrada,
+                           pp->longitudEntrada + minimo + 1)) {
+        return NULL;
+    }
+
+    *disponible = pp->capacidadEntrada - pp->longitudEntrada - 1;
+    return pp->bufferEntrada + pp->longitudEntrada;
+}
+
+/**
+ * @brief Quita del principio de la entrada el saludo de compresión que llegó
+ *        después de msNegociacion
+ * @return 1 si hay que esperar más bytes para decidirlo, 0 si no
+ */
+static int descartarSaludoTardio(ProcesoPar_t *pp) {
+    const char *saludo = PROCESOPAR_SALUDO_COMPRESION;
+    size_t longitudSaludo = strlen(saludo);
+    size_t pendiente = pp->longitudEntrada - pp->inicioEntrada;
+    size_t n = (pendiente < longitudSaludo) ? pendiente : longitudSaludo;
+
+    if (memcmp(pp->bufferEntrada + pp->inicioEntrada, saludo, n) != 0) {
+        pp->saludoTardio = 0;
+        return 0;
+    }
+    if (n < longitudSaludo) {
+        return 1;
+    }
+
+    /* Los delimitadores ya localizados dentro del saludo no cuentan */
+    pp->inicioEntrada += longitudSaludo;
+    while (pp->primerLimite < pp->numLimites &&
+           pp->limitesEntrada[pp->primerLimite] < pp->inicioEntrada) {
+        pp->primerLimite++;
+    }
+    if (pp->revisadoEntrada < pp->inicioEntrada) {
+        pp->revisadoEntrada = pp->inicioEntrada;
+    }
+    pp->saludoTardio = 0;
+    return 0;
+}
+
+int extraerMensaje(ProcesoPar_t *pp, size_t maximo, const char **mensaje, int *longitud) {
+    restaurarByteGuardado(pp);
+
+    if (pp->saludoTardio && pp->longitudEntrada > pp->inicioEntrada &&
+        descartarSaludoTardio(pp)) {
+        return 0;
+    }
+
+    size_t pendiente = pp->longitudEntrada - pp->inicioEntrada;
+    char *inicio = pp->bufferEntrada + pp->inicioEntrada;
+
+    if (pendiente == 0) {
+        return 0;
+    }
+
+    /* Sin tramas: se entrega todo lo leído (hasta `maximo`), como hacía el
+     * hilo original; lo que no quepa queda para la siguiente llamada */
+    if (!pp->compresion) {
+        size_t n = (pendiente < maximo) ? pendiente : maximo;
+
+        /* Con delimitador, hasta el delimitador incluido (`maximo` no se
+         * aplica, como con las tramas). Una pasada vectorizada localiza
+         * hasta PROCESOPAR_LIMITES_LOTE delimitadores, que se entregan en
+         * las llamadas siguientes sin volver a recorrer el buffer. */
+        if (pp->delimitador >= 0) {
+            if (pp->primerLimite == pp->numLimites) {
+                int encontrados = 0;
+                size_t revisados = 0;
+                buscarDelimitadores(pp->bufferEntrada + pp->revisadoEntrada,
+                                    pp->longitudEntrada - pp->revisadoEntrada,
+                                    pp->delimitador, pp->limitesEntrada,
+                                    PROCESOPAR_LIMITES_LOTE, &encontrados, &revisados);
+                for (int i = 0; i < encontrados; i++) {
+                    pp->limitesEntrada[i] += (uint32_t)pp->revisadoEntrada;
+                }
+                pp->revisadoEntrada += revisados;
+                pp->primerLimite = 0;
+                pp->numLimites = encontrados;
+            }
+
+            if (pp->primerLimite == pp->numLimites) {
+                if (pendiente > PROCESOPAR_TRAMA_MAXIMA) {
+                    return -1;
+                }
+                return 0;
+            }
+            n = pp->limitesEntrada[pp->primerLimite++] + 1 - pp->inicioEntrada;
+        }
+
+        pp->inicioEntrada += n;
+        guardarByteSiguiente(pp);
+        inicio[n] = '\0';
+        *mensaje = inicio;
+        *longitud = (int)n;
+        return 1;
+    }
+
+    /* Con tramas: esperar a tener la cabecera y la carga útil completas */
+    CabeceraTrama_t cabecera;
+    if (pendiente < sizeof(cabecera)) {
+        return 0;
+    }
+    memcpy(&cabecera, inicio, sizeof(cabecera));
+
+    if (cabecera.longitud > PROCESOPAR_TRAMA_MAXIMA ||
+        cabecera.longitudOriginal > PROCESOPAR_TRAMA_MAXIMA) {
+        return -1;
+    }
+    if (pendiente < sizeof(cabecera) + cabecera.longitud) {
+        return 0;
+    }
+
+    char *carga = inicio + sizeof(cabecera);
+    pp->inicioEntrada += sizeof(cabecera) + cabecera.longitud;
+
+    if (cabecera.longitud == cabecera.longitudOriginal) {
+        /* Trama sin comprimir: entregar en el sitio */
+        guardarByteSiguiente(pp);
+        carga[cabecera.longitud] = '\0';
+        *mensaje = carga;
+        *longitud = (int)cabecera.longitud;
+        return 1;
+    }
+
+    /* Trama comprimida: descomprimir en bufferMensaje */
+    if (!asegurarCapacidad(&pp->bufferMensaje, &pp->capacidadMensaje,
+                           (size_t)cabecera.longitudOriginal + 1)) {
+        return -1;
+    }
+
+    int longitudOriginal = 0;
+    unsigned long long t0 = tiempoNs();
+    Estado_t estado = descomprimirPPLZ(carga, (int)cabecera.longitud,
+                                       pp->bufferMensaje, (int)cabecera.longitudOriginal,
+                                       &longitudOriginal);
+    PP_SUMAR(pp->estadisticasCompresion.nsDescompresion, tiempoNs() - t0);
+
+    if (estado != E_OK || longitudOriginal != (int)cabecera.longitudOriginal) {
+        return -1;
+    }
+
+    PP_SUMAR(pp->estadisticasCompresion.mensajesDescomprimidos, 1);
+    PP_SUMAR(pp->estadisticasCompresion.bytesComprimidosRecibidos, cabecera.longitud);
+    PP_SUMAR(pp->estadisticasCompresion.bytesOriginalesRecibidos, longitudOriginal);
+
+    pp->bufferMensaje[longitudOriginal] = '\0';
+    *mensaje = pp->bufferMensaje;
+    *longitud = longitudOriginal;
+    return 1;
+}
+
+int hayMensajeCompleto(const ProcesoPar_t *pp) {
+    size_t pendiente = pp->longitudEntrada - pp->inicioEntrada;
+
+    if (!pp->compresion) {
+        if (pp->delimitador >= 0) {
+            /* El '\0' de la entrega anterior puede tapar un delimitador */
+            if (pp->hayByteGuardado && pp->posicionGuardada >= pp->revisadoEntrada &&
+                (unsigned char)pp->byteGuardado == (unsigned int)pp->delimitador) {
+                return 1;
+            }
+            return pp->primerLimite < pp->numLimites ||
+                   memchr(pp->bufferEntrada + pp->revisadoEntrada, pp->delimitador,
+                          pp->longitudEntrada - pp->revisadoEntrada) != NULL;
+        }
+        return pendiente > 0;
+    }
+
+    CabeceraTrama_t cabecera;
+    if (pendiente < sizeof(cabecera)) {
+        return 0;
+    }
+    memcpy(&cabecera, pp->bufferEntrada + pp->inicioEntrada, sizeof(cabecera));
+    return pendiente >= sizeof(cabecera) + cabecera.longitud;
+}
+
+#ifndef _WIN32
+int leerEntradaNoBloqueante(ProcesoPar_t *pp) {
+    int leidoAlgo = 0;
+
+    for (;;) {
+        size_t disponible;
+        char *destino = reservarEntrada(pp, tamanoLectura(pp), &disponible);
+        if (destino == NULL) {
+            return -1;
+        }
+
+        ssize_t leidos = read(pp->pipeEntrada[0], destino, disponible);
+        if (leidos > 0) {
+            PP_TRAZA(LECTURA, pp->pid, leidos);
+            pp->longitudEntrada += (size_t)leidos;
+            leidoAlgo = 1;
+            /* Lectura parcial: la tubería está vacía, ahorrar el EAGAIN */
+            if ((size_t)leidos < disponible) {
+                return 1;
+            }
+        } else if (leidos == 0) {
+            pp->finEntrada = 1;
+            return leidoAlgo ? 1 : -1;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return leidoAlgo;
+        } else {
+            pp->finEntrada = 1;
+            return leidoAlgo ? 1 : -1;
+        }
+    }
+}
+#endif
+
+void liberarBuffersProcesoPar(ProcesoPar_t *pp) {
+    free(pp->bufferEntrada);
+    free(pp->bufferMensaje);
+    free(pp->bufferEnvio);
+    pp->bufferEntrada = NULL;
+    pp->bufferMensaje = NULL;
+    pp->bufferEnvio = NULL;
+    pp->capacidadEntrada = 0;
+    pp->capacidadMensaje = 0;
+    pp->capacidadEnvio = 0;
+}
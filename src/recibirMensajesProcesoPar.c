@@ -0,0 +1,86 @@
+/**
+ * @file recibirMensajesProcesoPar.c
+ * @brief Implementación de la recepción no bloqueante sin hilo de escucha
+ */
+
+#include "ProcesoParInterno.h"
+#include <string.h>
+
+/**
+ * @brief Recibe sin bloquear los mensajes ya disponibles del hijo
+ */
+Estado_t recibirMensajesProcesoPar(
+    ProcesoPar_t *procesoPar,
+    MensajeRecibido_t *mensajes,
+    int maximo,
+    int *recibidos
+) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || mensajes == NULL || maximo <= 0 || recibidos == NULL) {
+        return E_PAR_INC;
+    }
+    for (int i = 0; i < maximo; i++) {
+        /* Al menos un byte de datos más el '\0' */
+        if (mensajes[i].datos == NULL || mensajes[i].capacidad < 2) {
+            return E_PAR_INC;
+        }
+    }
+
+    *recibidos = 0;
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    Estado_t estado = activarModoSondeo(procesoPar);
+    if (estado != E_OK) {
+        return estado;
+    }
+
+    /* Vaciar la tubería una vez; lo que no quepa en `mensajes` queda
+     * pendiente en bufferEntrada para la siguiente llamada */
+    if (!procesoPar->finEntrada) {
+        leerEntradaNoBloqueante(procesoPar);
+    }
+
+    int n = 0;
+    while (n < maximo) {
+        const char *mensaje;
+        int longitud;
+        MensajeRecibido_t *destino = &mensajes[n];
+
+        /* Sin tramas, partir lo leído para que quepa (con su '\0') */
+        int resultado = extraerMensaje(procesoPar, (size_t)destino->capacidad - 1,
+                                       &mensaje, &longitud);
+        if (resultado < 0) {
+            *recibidos = n;
+            return E_DATOS_CORRUPTOS;
+        }
+        if (resultado == 0) {
+            break;
+        }
+
+        PP_TRAZA(DESPACHO, procesoPar->pid, longitud);
+        PP_CAPTURAR(procesoPar, PROCESOPAR_CAPTURA_RECEPCION, mensaje, longitud);
+
+        int copiar = (longitud < destino->capacidad) ? longitud : destino->capacidad;
+        memcpy(destino->datos, mensaje, (size_t)copiar);
+        if (copiar < destino->capacidad) {
+            destino->datos[copiar] = '\0';
+        }
+        destino->longitud = longitud;
+        n++;
+    }
+
+    *recibidos = n;
+
+    if (n == 0 && procesoPar->finEntrada) {
+        return E_PROCESO_INACT;
+    }
+    return E_OK;
+#endif
+}
@@ -0,0 +1,127 @@
+/**
+ * @file reemplazarProcesoPar.c
+ * @brief Implementación de la sustitución de un hijo sin cortar el servicio
+ */
+
+#include "ProcesoParInterno.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <stdlib.h>
+
+/**
+ * @brief Proceso par sustituido que un hilo aparte drena
+ */
+typedef struct Drenaje {
+    ProcesoPar_t *pp;
+    unsigned long long nsLimite;
+} Drenaje_t;
+
+/**
+ * @brief Hilo que drena y destruye el proceso par sustituido
+ *
+ * Drenar espera a que salga el hijo anterior: hacerlo en quien reemplaza
+ * lo bloquearía hasta msDrenaje con el nuevo hijo ya atendiendo.
+ */
+static void *hiloDrenaje(void *param) {
+    Drenaje_t *d = (Drenaje_t*)param;
+    drenarProcesoPar(d->pp, d->nsLimite);
+    free(d);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Sustituye el hijo de un proceso par por uno nuevo sin cortar el servicio
+ */
+Estado_t reemplazarProcesoPar(
+    ProcesoPar_t **procesoPar,
+    const char *nombreArchivoEjecutable,
+    const char **listaLineaComando,
+    const OpcionesProcesoPar_t *opciones,
+    const OpcionesReemplazo_t *reemplazo
+) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || *procesoPar == NULL || nombreArchivoEjecutable == NULL ||
+        listaLineaComando == NULL) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!(*procesoPar)->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    (void)opciones;
+    (void)reemplazo;
+    return E_NO_SOPORTADO;
+#else
+    if (!opcionesReemplazoValidas(reemplazo)) {
+        return E_PAR_INC;
+    }
+
+    ProcesoPar_t *anterior = *procesoPar;
+
+    /* Drenar exige leer la tubería desde el hilo de escucha */
+    if (anterior->modoSondeo) {
+        return E_MODO;
+    }
+
+    /* Poner en marcha el nuevo hijo junto al actual */
+    ProcesoPar_t *nuevo = NULL;
+    Estado_t estado = lanzarProcesoParConOpciones(nombreArchivoEjecutable, listaLineaComando,
+                                                  opciones, &nuevo);
+    if (estado != E_OK) {
+        return estado;
+    }
+
+    estado = esperarListoProcesoPar(nuevo, reemplazo);
+
+    /* El nuevo atiende igual que el anterior: misma función de escucha y caché */
+    if (estado == E_OK && anterior->funcionEscucha != NULL) {
+        estado = establecerFuncionDeEscucha(nuevo, anterior->funcionEscucha);
+    }
+    if (estado == E_OK) {
+        size_t bytesCache = 0;
+        int msCache = 0;
+        pthread_mutex_lock(&anterior->mutexLlamadas);
+        if (anterior->cache != NULL) {
+            bytesCache = anterior->cache->bytesMaximos;
+            msCache = (int)(anterior->cache->nsVida / 1000000ULL);
+        }
+        pthread_mutex_unlock(&anterior->mutexLlamadas);
+        if (bytesCache > 0) {
+            estado = activarCacheProcesoPar(nuevo, bytesCache, msCache);
+        }
+    }
+
+    if (estado != E_OK) {
+        destruirProcesoPar(nuevo);
+        return estado;
+    }
+
+    /* A partir de aquí el tráfico nuevo va al nuevo hijo. Quien llama es el
+     * único dueño del proceso par: `anterior` pasa al hilo de drenaje, y
+     * cualquier copia del puntero que conserve otro hilo queda colgando */
+    *procesoPar = nuevo;
+
+    unsigned long long nsLimite = limiteReemplazo(reemplazo != NULL ? reemplazo->msDrenaje : 0,
+                                                  PROCESOPAR_MS_DRENAJE);
+    Drenaje_t *drenaje = (Drenaje_t*)malloc(sizeof(Drenaje_t));
+    if (drenaje != NULL) {
+        pthread_t hilo;
+        drenaje->pp = anterior;
+        drenaje->nsLimite = nsLimite;
+        if (pthread_create(&hilo, NULL, hiloDrenaje, drenaje) == 0) {
+            pthread_detach(hilo);
+            return E_OK;
+        }
+        free(drenaje);
+    }
+
+    /* Sin hilo de drenaje, drenar aquí */
+    drenarProcesoPar(anterior, nsLimite);
+    return E_OK;
+#endif
+}
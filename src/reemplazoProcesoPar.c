@@ -0,0 +1,228 @@
+/**
+ * @file reemplazoProcesoPar.c
+ * @brief Funciones internas para poner en servicio y retirar procesos pares
+ *
+ * Un hijo nuevo entra en servicio cuando envía su mensaje de listo. Uno
+ * retirado se drena cerrando su entrada estándar: termina lo que tenga en
+ * curso, el hilo de escucha entrega sus últimas respuestas y ve el EOF.
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <errno.h>
+    #include <poll.h>
+    #include <signal.h>
+    #include <pthread.h>
+    #include <time.h>
+    #include <sys/wait.h>
+#endif
+
+#ifndef _WIN32
+
+int opcionesReemplazoValidas(const OpcionesReemplazo_t *reemplazo) {
+    if (reemplazo == NULL) {
+        return 1;
+    }
+    return reemplazo->msListo >= 0 && reemplazo->msDrenaje >= 0 && reemplazo->exceso >= 0 &&
+           (reemplazo->mensajeListo == NULL || reemplazo->longitudListo > 0);
+}
+
+unsigned long long limiteReemplazo(int ms, int msDefecto) {
+    return tiempoNs() + (unsigned long long)(ms > 0 ? ms : msDefecto) * 1000000ULL;
+}
+
+/**
+ * @brief Pasa un instante de tiempoNs() a timespec (reloj monotónico)
+ */
+static struct timespec instanteMonotonico(unsigned long long ns) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / 1000000000ULL);
+    ts.tv_nsec = (long)(ns % 1000000000ULL);
+    return ts;
+}
+
+Estado_t esperarListoProcesoPar(ProcesoPar_t *pp, const OpcionesReemplazo_t *reemplazo) {
+    if (reemplazo == NULL || reemplazo->mensajeListo == NULL) {
+        return E_OK;
+    }
+
+    size_t longitud = (size_t)reemplazo->longitudListo;
+    unsigned long long limite = limiteReemplazo(reemplazo->msListo, PROCESOPAR_MS_LISTO);
+
+    for (;;) {
+        /* Con tramas el mensaje de listo es una trama; sin ellas, los
+         * primeros `longitud` bytes (no se lee más allá) */
+        if (pp->compresion) {
+            const char *mensaje;
+            int n;
+            int resultado = extraerMensaje(pp, (size_t)-1, &mensaje, &n);
+            if (resultado < 0) {
+                return E_DATOS_CORRUPTOS;
+            }
+            if (resultado > 0) {
+                return ((size_t)n == longitud && memcmp(mensaje, reemplazo->mensajeListo, longitud) == 0)
+                    ? E_OK : E_DATOS_CORRUPTOS;
+            }
+        } else if (pp->longitudEntrada - pp->inicioEntrada >= longitud) {
+            if (memcmp(pp->bufferEntrada + pp->inicioEntrada, reemplazo->mensajeListo, longitud) != 0) {
+                return E_DATOS_CORRUPTOS;
+            }
+            pp->inicioEntrada += longitud;
+            pp->revisadoEntrada = pp->inicioEntrada;
+            return E_OK;
+        }
+
+        unsigned long long ahora = tiempoNs();
+        if (ahora >= limite) {
+            return E_TIEMPO;
+        }
+
+        struct pollfd pfd = { pp->pipeEntrada[0], POLLIN, 0 };
+        int listo = poll(&pfd, 1, (int)((limite - ahora + 999999ULL) / 1000000ULL));
+        if (listo == -1 && errno == EINTR) {
+            continue;
+        }
+        if (listo == 0) {
+            return E_TIEMPO;
+        }
+        if (listo < 0) {
+            return E_PROCESO_INACT;
+        }
+
+        size_t faltan = pp->compresion
+            ? tamanoLectura(pp)
+            : longitud - (pp->longitudEntrada - pp->inicioEntrada);
+        size_t disponible;
+        char *destino = reservarEntrada(pp, faltan, &disponible);
+        if (destino == NULL) {
+            return E_NO_MEMORIA;
+        }
+
+        ssize_t leidos = read(pp->pipeEntrada[0], destino, pp->compresion ? disponible : faltan);
+        if (leidos == -1 && errno == EINTR) {
+            continue;
+        }
+        if (leidos <= 0) {
+            return E_PROCESO_INACT;
+        }
+        pp->longitudEntrada += (size_t)leidos;
+    }
+}
+
+/**
+ * @brief Recoge al hijo sin bloquear hasta `nsLimite` (al menos una breve
+ *        gracia); si sigue vivo, lo mata para que destruirProcesoPar no
+ *        quede esperando en waitpid
+ */
+static void rematarHijo(ProcesoPar_t *pp, unsigned long long nsLimite) {
+    if (pp->pid <= 0) {
+        return;
+    }
+
+    unsigned long long gracia = tiempoNs() + PP_MS_GRACIA_DRENAJE * 1000000ULL;
+    unsigned long long limite = (nsLimite > gracia) ? nsLimite : gracia;
+
+    for (;;) {
+        pid_t resultado = waitpid(pp->pid, NULL, WNOHANG);
+        if (resultado == -1 && errno == EINTR) {
+            continue;
+        }
+        if (resultado != 0) {
+            /* Recogido (o ya no es hijo nuestro): nada que esperar */
+            pp->pid = -1;
+            return;
+        }
+        if (tiempoNs() >= limite) {
+            break;
+        }
+        usleep(1000);
+    }
+
+    kill(pp->pid, SIGKILL);
+}
+
+void drenarProcesoPar(ProcesoPar_t *pp, unsigned long long nsLimite) {
+    /* Un hijo que termina lo pendiente no debe tomarse por atascado */
+    desregistrarLatidoProcesoPar(pp);
+
+    /* Alguien tiene que leer las últimas respuestas y ver el EOF */
+    pthread_mutex_lock(&pp->mutexOrden);
+    if (!pp->hiloCreado && !pp->modoSondeo) {
+        crearHiloEscucha(pp);
+    }
+    pthread_mutex_unlock(&pp->mutexOrden);
+
+    /* Sin más entrada, el hijo termina lo pendiente y sale */
+    pthread_mutex_lock(&pp->mutexEnvio);
+    if (pp->pipeSalida[1] != -1) {
+        close(pp->pipeSalida[1]);
+        pp->pipeSalida[1] = -1;
+    }
+    pthread_mutex_unlock(&pp->mutexEnvio);
+
+    if (pp->hiloCreado) {
+        struct timespec limite = instanteMonotonico(nsLimite);
+        pthread_mutex_lock(&pp->mutexLlamadas);
+        while (!pp->finEntrada) {
+            if (pthread_cond_timedwait(&pp->condLlamadas, &pp->mutexLlamadas, &limite) == ETIMEDOUT) {
+                break;
+            }
+        }
+        pthread_mutex_unlock(&pp->mutexLlamadas);
+    }
+
+    rematarHijo(pp, nsLimite);
+    destruirProcesoPar(pp);
+}
+
+MiembroGrupo_t *tomarMiembroGrupo(GrupoProcesoPar_t *grupo) {
+    MiembroGrupo_t *miembro = NULL;
+
+    pthread_mutex_lock(&grupo->mutex);
+    if (grupo->numero > 0) {
+        miembro = grupo->miembros[grupo->siguiente++ % (unsigned int)grupo->numero];
+        miembro->usos++;
+    }
+    pthread_mutex_unlock(&grupo->mutex);
+
+    return miembro;
+}
+
+void soltarMiembroGrupo(GrupoProcesoPar_t *grupo, MiembroGrupo_t *miembro) {
+    pthread_mutex_lock(&grupo->mutex);
+    if (--miembro->usos == 0) {
+        pthread_cond_broadcast(&grupo->condicion);
+    }
+    pthread_mutex_unlock(&grupo->mutex);
+}
+
+void retirarMiembroGrupo(GrupoProcesoPar_t *grupo, MiembroGrupo_t *miembro,
+                         unsigned long long nsLimite) {
+    struct timespec limite = instanteMonotonico(nsLimite);
+
+    pthread_mutex_lock(&grupo->mutex);
+    while (miembro->usos > 0) {
+        if (pthread_cond_timedwait(&grupo->condicion, &grupo->mutex, &limite) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    if (miembro->usos > 0) {
+        /* Plazo cumplido: con el hijo muerto, el hilo de escucha falla las
+         * llamadas en curso y sus hilos sueltan el miembro enseguida */
+        kill(miembro->pp->pid, SIGKILL);
+        while (miembro->usos > 0) {
+            pthread_cond_wait(&grupo->condicion, &grupo->mutex);
+        }
+    }
+    pthread_mutex_unlock(&grupo->mutex);
+
+    drenarProcesoPar(miembro->pp, nsLimite);
+    free(miembro);
+}
+
+#endif
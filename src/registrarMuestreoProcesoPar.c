@@ -0,0 +1,110 @@
+/**
+ * @file registrarMuestreoProcesoPar.c
+ * @brief Implementación del registro de un proceso par en el muestreador
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#ifndef _WIN32
+/**
+ * @brief Abre /proc/<pid>/<archivo> para releerlo con pread
+ */
+static int abrirProc(pid_t pid, const char *archivo) {
+    char ruta[64];
+    snprintf(ruta, sizeof(ruta), "/proc/%d/%s", (int)pid, archivo);
+    return open(ruta, O_RDONLY | O_CLOEXEC);
+}
+
+/**
+ * @brief Cierra los archivos abiertos de un registro sin enlazar y lo libera
+ */
+static void liberarRegistro(MuestreoRecursos_t *m) {
+    int fds[4] = { m->fdStat, m->fdStatm, m->fdIo, m->fdStatus };
+    for (int i = 0; i < 4; i++) {
+        if (fds[i] != -1) {
+            close(fds[i]);
+        }
+    }
+    free(m->muestras);
+    free(m);
+}
+#endif
+
+/**
+ * @brief Registra un proceso par en el muestreador de recursos
+ */
+Estado_t registrarMuestreoProcesoPar(ProcesoPar_t *procesoPar, int capacidad) {
+    /* Validar parámetros */
+    if (procesoPar == NULL || capacidad < 0) {
+        return E_PAR_INC;
+    }
+
+    /* Verificar que el proceso esté activo */
+    if (!procesoPar->activo) {
+        return E_PROCESO_INACT;
+    }
+
+#ifdef _WIN32
+    return E_NO_SOPORTADO;
+#else
+    /* pp->muestreo solo se lee y escribe con el mutex del muestreador */
+    pthread_mutex_lock(&muestreador.mutex);
+    int registrado = (procesoPar->muestreo != NULL);
+    pthread_mutex_unlock(&muestreador.mutex);
+    if (registrado) {
+        return E_OK;
+    }
+
+    if (capacidad == 0) {
+        capacidad = PROCESOPAR_MUESTRAS_DEFECTO;
+    }
+
+    MuestreoRecursos_t *m = (MuestreoRecursos_t*)calloc(1, sizeof(MuestreoRecursos_t));
+    if (m == NULL) {
+        return E_NO_MEMORIA;
+    }
+    m->muestras = (MuestraRecursos_t*)calloc((size_t)capacidad, sizeof(MuestraRecursos_t));
+    if (m->muestras == NULL) {
+        free(m);
+        return E_NO_MEMORIA;
+    }
+
+    m->pp = procesoPar;
+    m->capacidad = capacidad;
+
+    /* stat es imprescindible; io puede no existir en kernels sin
+     * CONFIG_TASK_IO_ACCOUNTING, y entonces simplemente no se rellena */
+    m->fdStat = abrirProc(procesoPar->pid, "stat");
+    m->fdStatm = abrirProc(procesoPar->pid, "statm");
+    m->fdIo = abrirProc(procesoPar->pid, "io");
+    m->fdStatus = abrirProc(procesoPar->pid, "status");
+
+    if (m->fdStat == -1) {
+        liberarRegistro(m);
+        return E_PROCESO_INACT;
+    }
+
+    pthread_mutex_lock(&muestreador.mutex);
+
+    /* Otro hilo pudo registrarlo mientras se abrían los archivos */
+    if (procesoPar->muestreo != NULL) {
+        pthread_mutex_unlock(&muestreador.mutex);
+        liberarRegistro(m);
+        return E_OK;
+    }
+
+    m->siguiente = muestreador.lista;
+    muestreador.lista = m;
+    procesoPar->muestreo = m;
+    pthread_mutex_unlock(&muestreador.mutex);
+
+    return E_OK;
+#endif
+}
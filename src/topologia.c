@@ -0,0 +1,137 @@
+/**
+ * @file topologia.c
+ * @brief Funciones internas para leer la topología de CPUs y nodos NUMA
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <pthread.h>
+#endif
+
+#ifndef _WIN32
+
+/* Topología leída una sola vez: las CPUs de cada nodo, una lista tras otra */
+static struct {
+    int numNodos;                    /* Hasta el último nodo con CPUs (al menos 1) */
+    int inicio[PP_MAX_NODOS];        /* Posición en cpus de la primera CPU del nodo */
+    int numCpus[PP_MAX_NODOS];       /* CPUs del nodo, o -1 si no existe */
+    int cpus[PP_MAX_CPUS];
+} topologia;
+static pthread_once_t topologiaUnaVez = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Interpreta una lista de CPUs del kernel ("0-3,8,10-11")
+ */
+static int interpretarListaCpus(const char *texto, int *cpus, int maximo) {
+    int n = 0;
+    const char *p = texto;
+
+    while (*p != '\0' && *p != '\n') {
+        char *fin;
+        long desde = strtol(p, &fin, 10);
+        if (fin == p) {
+            break;
+        }
+        long hasta = desde;
+        p = fin;
+        if (*p == '-') {
+            hasta = strtol(p + 1, &fin, 10);
+            p = fin;
+        }
+        for (long c = desde; c <= hasta && n < maximo; c++) {
+            cpus[n++] = (int)c;
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Lee de sysfs las CPUs de un nodo NUMA
+ * @return Número de CPUs escritas en cpus, o -1 si el nodo no existe
+ */
+static int leerCpusNodoSysfs(int nodo, int *cpus, int maximo) {
+    char ruta[96];
+    char texto[4096];
+
+    snprintf(ruta, sizeof(ruta), "/sys/devices/system/node/node%d/cpulist", nodo);
+    FILE *f = fopen(ruta, "r");
+
+    if (f == NULL) {
+        /* Sin NUMA: el nodo 0 son todas las CPUs en línea */
+        if (nodo != 0) {
+            return -1;
+        }
+        f = fopen("/sys/devices/system/cpu/online", "r");
+        if (f == NULL) {
+            long enLinea = sysconf(_SC_NPROCESSORS_ONLN);
+            int n = 0;
+            for (long c = 0; c < enLinea && n < maximo; c++) {
+                cpus[n++] = (int)c;
+            }
+            return n;
+        }
+    }
+
+    int n = 0;
+    if (fgets(texto, sizeof(texto), f) != NULL) {
+        n = interpretarListaCpus(texto, cpus, maximo);
+    }
+    fclose(f);
+    return n;
+}
+
+/**
+ * @brief Lee la topología de todos los nodos (una vez por proceso)
+ */
+static void leerTopologia(void) {
+    int usadas = 0;
+    int nodos = 0;
+
+    /* Los nodos pueden no ser consecutivos si alguno está fuera de línea:
+     * se cuentan hasta el último que tiene CPUs */
+    for (int nodo = 0; nodo < PP_MAX_NODOS; nodo++) {
+        int n = leerCpusNodoSysfs(nodo, topologia.cpus + usadas, PP_MAX_CPUS - usadas);
+        topologia.inicio[nodo] = usadas;
+        topologia.numCpus[nodo] = n;
+        if (n > 0) {
+            usadas += n;
+            nodos = nodo + 1;
+        }
+    }
+
+    topologia.numNodos = (nodos > 0) ? nodos : 1;
+}
+
+int leerCpusNodo(int nodo, int *cpus, int maximo) {
+    if (nodo < 0 || nodo >= PP_MAX_NODOS) {
+        return -1;
+    }
+
+    pthread_once(&topologiaUnaVez, leerTopologia);
+
+    int n = topologia.numCpus[nodo];
+    if (n < 0) {
+        return -1;
+    }
+    if (n > maximo) {
+        n = maximo;
+    }
+    memcpy(cpus, topologia.cpus + topologia.inicio[nodo], (size_t)n * sizeof(int));
+    return n;
+}
+
+int contarNodosNuma(void) {
+    pthread_once(&topologiaUnaVez, leerTopologia);
+    return topologia.numNodos;
+}
+
+#endif
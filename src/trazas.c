@@ -0,0 +1,153 @@
+/**
+ * @file trazas.c
+ * @brief Anillos de trazas por hilo, sin cerrojos (solo con PROCESOPAR_TRAZAS)
+ *
+ * Cada hilo que registra un evento obtiene su propio anillo la primera vez;
+ * solo ese hilo escribe en él, así que basta con publicar el contador de
+ * eventos con semántica release. Los anillos se enlazan en una lista global
+ * (inserción con CAS) y nunca se liberan, para poder volcarlos aunque el
+ * hilo haya terminado. Al terminar el hilo, su anillo queda libre: otro
+ * hilo lo reutiliza en cuanto se ha volcado o, si ya hay
+ * PP_MAX_ANILLOS_TRAZA anillos, aunque no se haya volcado. Así los hilos de
+ * vida corta (relanzamientos, drenajes) no hacen crecer la memoria.
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdlib.h>
+
+#ifdef PROCESOPAR_TRAZAS
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <pthread.h>
+    #include <sys/syscall.h>
+#endif
+
+AnilloTraza_t *listaAnillosTraza = NULL;
+
+static __thread AnilloTraza_t *anilloHilo = NULL;
+static __thread int sinAnillo = 0;
+
+static long idHiloActual(void) {
+#ifdef _WIN32
+    return (long)GetCurrentThreadId();
+#else
+    return (long)syscall(SYS_gettid);
+#endif
+}
+
+#ifndef _WIN32
+static pthread_key_t claveAnillo;
+static pthread_once_t claveCreada = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Destructor de la clave: el hilo termina y su anillo queda libre
+ */
+static void liberarAnilloHilo(void *param) {
+    AnilloTraza_t *anillo = (AnilloTraza_t*)param;
+    anilloHilo = NULL;
+    __atomic_store_n(&anillo->libre, 1, __ATOMIC_RELEASE);
+}
+
+static void crearClaveAnillo(void) {
+    pthread_key_create(&claveAnillo, liberarAnilloHilo);
+}
+
+/**
+ * @brief Toma un anillo libre de la lista, si lo hay y se puede reutilizar
+ *
+ * Primero uno ya volcado; con demasiados anillos, el libre más antiguo.
+ */
+static AnilloTraza_t *reutilizarAnillo(void) {
+    AnilloTraza_t *antiguo = NULL;
+    int total = 0;
+
+    AnilloTraza_t *anillo = __atomic_load_n(&listaAnillosTraza, __ATOMIC_ACQUIRE);
+    for (; anillo != NULL; anillo = anillo->siguiente) {
+        total++;
+        if (!__atomic_load_n(&anillo->libre, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        int libre = 1;
+        if (__atomic_load_n(&anillo->volcados, __ATOMIC_ACQUIRE) == anillo->escritos &&
+            __atomic_compare_exchange_n(&anillo->libre, &libre, 0, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            return anillo;
+        }
+        /* La lista va del más nuevo al más antiguo */
+        antiguo = anillo;
+    }
+
+    int libre = 1;
+    if (total >= PP_MAX_ANILLOS_TRAZA && antiguo != NULL &&
+        __atomic_compare_exchange_n(&antiguo->libre, &libre, 0, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        return antiguo;
+    }
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Obtiene un anillo para el hilo actual, reutilizado o nuevo
+ */
+static AnilloTraza_t *asignarAnillo(void) {
+    AnilloTraza_t *anillo;
+
+#ifndef _WIN32
+    pthread_once(&claveCreada, crearClaveAnillo);
+
+    anillo = reutilizarAnillo();
+    if (anillo != NULL) {
+        /* Los eventos del hilo anterior ya no se volcarán */
+        anillo->tid = idHiloActual();
+        __atomic_store_n(&anillo->volcados, 0ULL, __ATOMIC_RELAXED);
+        __atomic_store_n(&anillo->escritos, 0ULL, __ATOMIC_RELEASE);
+        pthread_setspecific(claveAnillo, anillo);
+        return anillo;
+    }
+#endif
+
+    anillo = (AnilloTraza_t*)calloc(1, sizeof(AnilloTraza_t));
+    if (anillo == NULL) {
+        return NULL;
+    }
+    anillo->tid = idHiloActual();
+
+    /* Publicar el anillo en la lista global */
+    anillo->siguiente = __atomic_load_n(&listaAnillosTraza, __ATOMIC_ACQUIRE);
+    while (!__atomic_compare_exchange_n(&listaAnillosTraza, &anillo->siguiente, anillo,
+                                        1, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+    }
+#ifndef _WIN32
+    pthread_setspecific(claveAnillo, anillo);
+#endif
+    return anillo;
+}
+
+void registrarTraza(EventoTraza_t evento, long pid, long long valor) {
+    AnilloTraza_t *anillo = anilloHilo;
+
+    if (anillo == NULL) {
+        /* Si ya falló la reserva, no reintentar en cada evento */
+        if (sinAnillo) {
+            return;
+        }
+        anillo = asignarAnillo();
+        if (anillo == NULL) {
+            sinAnillo = 1;
+            return;
+        }
+        anilloHilo = anillo;
+    }
+
+    unsigned long long n = anillo->escritos;
+    EventoRegistrado_t *e = &anillo->eventos[n % PP_EVENTOS_POR_HILO];
+    e->ns = tiempoNs();
+    e->evento = (int)evento;
+    e->pid = pid;
+    e->valor = valor;
+    __atomic_store_n(&anillo->escritos, n + 1, __ATOMIC_RELEASE);
+}
+
+#endif
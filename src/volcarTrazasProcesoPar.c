@@ -0,0 +1,98 @@
+/**
+ * @file volcarTrazasProcesoPar.c
+ * @brief Implementación del volcado de trazas en formato Chrome trace
+ */
+
+#include "ProcesoParInterno.h"
+#include <stdio.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+#ifdef PROCESOPAR_TRAZAS
+
+/* Nombre y fase (B = inicio, E = fin, i = instantáneo) de cada evento */
+static const struct {
+    const char *nombre;
+    char fase;
+} descripcionEvento[PP_NUM_EVENTOS] = {
+    { "envio",       'B' },
+    { "envio",       'E' },
+    { "lectura",     'i' },
+    { "despacho",    'i' },
+    { "callback",    'B' },
+    { "callback",    'E' },
+    { "lanzamiento", 'i' },
+    { "destruccion", 'i' },
+};
+
+#endif
+
+/**
+ * @brief Vuelca los anillos de trazas de todos los hilos a un archivo JSON
+ */
+Estado_t volcarTrazasProcesoPar(const char *rutaArchivo) {
+    /* Validar parámetro */
+    if (rutaArchivo == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifndef PROCESOPAR_TRAZAS
+    return E_NO_SOPORTADO;
+#else
+    FILE *f = fopen(rutaArchivo, "w");
+    if (f == NULL) {
+        return E_PAR_INC;
+    }
+
+#ifdef _WIN32
+    long pidPadre = (long)GetCurrentProcessId();
+#else
+    long pidPadre = (long)getpid();
+#endif
+
+    fputs("{\"traceEvents\":[\n", f);
+    int primero = 1;
+
+    AnilloTraza_t *anillo = __atomic_load_n(&listaAnillosTraza, __ATOMIC_ACQUIRE);
+    for (; anillo != NULL; anillo = anillo->siguiente) {
+        /* El hilo puede seguir escribiendo: volcar lo publicado hasta ahora.
+         * Si da la vuelta durante el volcado, los eventos más antiguos
+         * pueden salir mezclados con otros nuevos (volcado "best effort") */
+        unsigned long long fin = __atomic_load_n(&anillo->escritos, __ATOMIC_ACQUIRE);
+        unsigned long long inicio = (fin > PP_EVENTOS_POR_HILO) ? fin - PP_EVENTOS_POR_HILO : 0;
+
+        for (unsigned long long i = inicio; i < fin; i++) {
+            const EventoRegistrado_t *e = &anillo->eventos[i % PP_EVENTOS_POR_HILO];
+            if (e->evento < 0 || e->evento >= PP_NUM_EVENTOS) {
+                continue;
+            }
+
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%ld,"
+                       "%s\"args\":{\"hijo\":%ld,\"valor\":%lld}}",
+                    primero ? "" : ",\n",
+                    descripcionEvento[e->evento].nombre,
+                    descripcionEvento[e->evento].fase,
+                    e->ns / 1000.0,
+                    pidPadre,
+                    anillo->tid,
+                    descripcionEvento[e->evento].fase == 'i' ? "\"s\":\"t\"," : "",
+                    e->pid,
+                    e->valor);
+            primero = 0;
+        }
+
+        /* Lo volcado de un hilo terminado ya no hace falta: el anillo se
+         * puede reutilizar sin perder nada */
+        __atomic_store_n(&anillo->volcados, fin, __ATOMIC_RELEASE);
+    }
+
+    fputs("\n]}\n", f);
+
+    if (fclose(f) != 0) {
+        return E_ENVIO_FALLO;
+    }
+    return E_OK;
+#endif
+}